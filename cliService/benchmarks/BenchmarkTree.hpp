@@ -0,0 +1,72 @@
+#pragma once
+#include "cliService/tree/Directory.hpp"
+#include "cliService/tree/CommandIf.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace cliService
+{
+
+  enum class AccessLevel
+  {
+    User,
+    Admin
+  };
+
+  class NoopCommand : public CommandIf
+  {
+  public:
+    using CommandIf::CommandIf;
+
+    CLIResponse execute(const std::vector<std::string>& args) override
+    {
+      (void)(args);
+      return CLIResponse::success();
+    }
+  };
+
+  // Regular tree used by all benchmarks. Every directory above 'depth' holds
+  // 'fanOut' subdirectories "dir<i>" and 'fanOut' commands "cmd<i>", so the
+  // last child of each kind is the worst case for a linear child search.
+  inline void populateTree(Directory& dir, size_t depth, size_t fanOut)
+  {
+    for (size_t i = 0; i < fanOut; ++i) {
+      dir.addDynamicCommand<NoopCommand>("cmd" + std::to_string(i), AccessLevel::User);
+    }
+
+    if (depth == 0) { return; }
+
+    for (size_t i = 0; i < fanOut; ++i) {
+      populateTree(dir.addDynamicDirectory("dir" + std::to_string(i), AccessLevel::User), depth - 1, fanOut);
+    }
+  }
+
+
+  inline std::unique_ptr<Directory> buildTree(size_t depth, size_t fanOut)
+  {
+    auto root = std::make_unique<Directory>("root", AccessLevel::User);
+    populateTree(*root, depth, fanOut);
+    return root;
+  }
+
+
+  // Elements of the deepest directory reached through the last child at every level
+  inline std::vector<std::string> deepestDirectoryElements(size_t depth, size_t fanOut)
+  {
+    return std::vector<std::string>(depth, "dir" + std::to_string(fanOut - 1));
+  }
+
+
+  inline std::string deepestCommandPath(size_t depth, size_t fanOut)
+  {
+    std::string path;
+
+    for (const auto& element : deepestDirectoryElements(depth, fanOut)) {
+      path += "/" + element;
+    }
+
+    return path + "/cmd" + std::to_string(fanOut - 1);
+  }
+
+}
@@ -0,0 +1,132 @@
+#include "benchmark/benchmark.h"
+#include "BenchmarkTree.hpp"
+#include "cliService/cli/CLIService.hpp"
+#include "cliService/cli/CommandHistory.hpp"
+#include "cliService/cli/InputParser.hpp"
+#include "cliService/cli/UserStore.hpp"
+#include "mock/io/CharIOStreamMock.hpp"
+
+namespace cliService
+{
+
+  static void BM_InputParserParseToPathAndArgs(benchmark::State& state)
+  {
+    std::string input = "/dir0/dir1/cmd2";
+    for (int64_t i = 0; i < state.range(0); ++i) {
+      input += " arg" + std::to_string(i);
+    }
+
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(InputParser::parseToPathAndArgs(input));
+    }
+  }
+  BENCHMARK(BM_InputParserParseToPathAndArgs)->ArgName("args")->Arg(0)->Arg(4)->Arg(16);
+
+
+  static void BM_CommandHistoryAddCommand(benchmark::State& state)
+  {
+    // A full history, so every add also evicts the oldest entry
+    CommandHistory history(state.range(0));
+    std::vector<std::string> commands;
+    for (int64_t i = 0; i < state.range(0) + 1; ++i) {
+      commands.push_back("/dir0/cmd" + std::to_string(i));
+    }
+    for (const auto& command : commands) {
+      history.addCommand(command);
+    }
+
+    size_t next = 0;
+    for (auto _ : state)
+    {
+      history.addCommand(commands[next]);
+      next = (next + 1) % commands.size();
+    }
+  }
+  BENCHMARK(BM_CommandHistoryAddCommand)->ArgName("historySize")->Arg(10)->Arg(100)->Arg(1000);
+
+
+  // End to end: parse, resolve, authorize, execute and print one command line
+  static void BM_CLIServiceService(benchmark::State& state)
+  {
+    auto root = buildTree(state.range(0), state.range(1));
+    const std::vector<User> users = {{"user", "user123", AccessLevel::User}};
+    const std::string line = deepestCommandPath(state.range(0), state.range(1)) + "\n";
+
+    CharIOStreamMock ioStream;
+    CLIService service(CLIServiceConfiguration{ioStream, users, *root, 1000, 10});
+    service.activate();
+    ioStream.queueInput("user:user123\n");
+    service.service();
+
+    for (auto _ : state)
+    {
+      ioStream.queueInput(line);
+      service.service();
+
+      state.PauseTiming();
+      ioStream.clearOutput();
+      state.ResumeTiming();
+    }
+  }
+  BENCHMARK(BM_CLIServiceService)
+    ->ArgNames({"depth", "fanOut"})
+    ->ArgsProduct({{1, 3, 5}, {2, 4}})
+    ->Args({2, 64});
+
+
+  // Logins per second against the hashed store, dominated by the work factor
+  static void BM_UserStoreAuthenticate(benchmark::State& state)
+  {
+    const auto iterations = static_cast<uint32_t>(state.range(0));
+    const UserStore::Salt salt = {};
+    const auto hash = UserStore::hashPassword("password", salt, iterations);
+
+    // Provisioned hashes, hashing every account here would dwarf the run
+    UserStore store(iterations);
+    for (int64_t i = 0; i < state.range(1); ++i) {
+      store.addHashedUser("user" + std::to_string(i), AccessLevel::User, salt, hash, iterations);
+    }
+
+    const std::string username = "user" + std::to_string(state.range(1) - 1);
+    const std::string password = "password";
+
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(store.authenticate(username, password));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+  }
+  BENCHMARK(BM_UserStoreAuthenticate)
+    ->ArgNames({"iterations", "users"})
+    ->ArgsProduct({{1000, 10000}, {1, 1000}});
+
+
+  // service() calls of a session backing off after failed logins, with a
+  // scripted attempt already waiting in the stream
+  static void BM_CLIServiceThrottledLogin(benchmark::State& state)
+  {
+    auto root = buildTree(1, 1);
+    CharIOStreamMock ioStream;
+    CLIServiceConfiguration config{ioStream, {{"user", "user123", AccessLevel::User}}, *root, 1000, 10};
+    config._loginBackoff_ms = 3600000;
+    config._maxLoginBackoff_ms = 3600000;
+
+    CLIService service(std::move(config));
+    service.activate();
+
+    for (uint32_t i = 0; i <= LoginThrottle::FREE_FAILURES; ++i)
+    {
+      ioStream.queueInput("user:guess\n");
+      service.service();
+    }
+    ioStream.queueInput("user:guess\n");
+
+    for (auto _ : state) {
+      service.service();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+  }
+  BENCHMARK(BM_CLIServiceThrottledLogin);
+
+}
@@ -0,0 +1,112 @@
+#include "benchmark/benchmark.h"
+#include "BenchmarkTree.hpp"
+#include "cliService/tree/PathCompleter.hpp"
+#include "cliService/tree/PathResolver.hpp"
+#include "generator/TreeGenerator.hpp"
+#include "util/AllocationCounter.hpp"
+
+namespace cliService
+{
+
+  // Arguments: {depth}, fan-out 10, so roughly 10^depth nodes capped at 1M
+  static TreeGeneratorConfig generatedConfig(int64_t depth)
+  {
+    TreeGeneratorConfig config;
+    config.depth = static_cast<size_t>(depth);
+    config.fanOut = 10;
+    config.commandRatio = 0.0;
+    config.publicLevel = AccessLevel::User;
+    config.restrictedLevel = AccessLevel::Admin;
+    config.restrictedRatio = 0.1;
+    config.maxNodes = 1000000;
+    return config;
+  }
+
+
+  static void BM_GenerateTree(benchmark::State& state)
+  {
+    TreeGenerator generator(generatedConfig(state.range(0)));
+    size_t treeBytes = 0;
+
+    for (auto _ : state)
+    {
+      const size_t before = AllocationCounter::getLiveBytes();
+      auto root = generator.generate();
+      treeBytes = AllocationCounter::getLiveBytes() - before;
+
+      state.PauseTiming();
+      root.reset();
+      state.ResumeTiming();
+    }
+
+    const auto& stats = generator.getStats();
+    state.counters["nodes"] = static_cast<double>(stats.nodeCount);
+    state.counters["build_ms"] = stats.buildTime_ms;
+    state.counters["bytes/node"] = static_cast<double>(treeBytes) / stats.nodeCount;
+    state.counters["nameBytes/node"] = static_cast<double>(stats.nameBytes) / stats.nodeCount;
+  }
+  BENCHMARK(BM_GenerateTree)->ArgName("depth")->DenseRange(3, 6)->Unit(benchmark::kMillisecond);
+
+
+  static void BM_FreezeGeneratedTree(benchmark::State& state)
+  {
+    TreeGenerator generator(generatedConfig(state.range(0)));
+    auto root = generator.generate();
+    size_t frozenBytes = 0;
+
+    for (auto _ : state)
+    {
+      const size_t before = AllocationCounter::getLiveBytes();
+      root->freeze();
+      frozenBytes = AllocationCounter::getLiveBytes() - before;
+
+      state.PauseTiming();
+      root = generator.generate();
+      state.ResumeTiming();
+    }
+
+    state.counters["nodes"] = static_cast<double>(generator.getStats().nodeCount);
+    state.counters["bytes/node"] = static_cast<double>(frozenBytes) / generator.getStats().nodeCount;
+  }
+  BENCHMARK(BM_FreezeGeneratedTree)->ArgName("depth")->DenseRange(3, 6)->Unit(benchmark::kMillisecond);
+
+
+  // Resolve the absolute path of a sample of nodes spread over the tree
+  template<bool Frozen>
+  static void BM_ResolveGeneratedTree(benchmark::State& state)
+  {
+    TreeGenerator generator(generatedConfig(state.range(0)));
+    auto root = generator.generate();
+    if (Frozen) { root->freeze(); }
+
+    std::vector<Path> paths;
+    size_t index = 0;
+    root->visit([&](const NodeIf& node, size_t) {
+      if (index++ % 101 == 0) { paths.push_back(PathResolver::getAbsolutePath(node)); }
+    });
+
+    PathResolver resolver(*root);
+    size_t next = 0;
+
+    for (auto _ : state)
+    {
+      benchmark::DoNotOptimize(resolver.resolve(paths[next], *root));
+      next = (next + 1) % paths.size();
+    }
+  }
+  BENCHMARK(BM_ResolveGeneratedTree<false>)->ArgName("depth")->DenseRange(3, 6);
+  BENCHMARK(BM_ResolveGeneratedTree<true>)->ArgName("depth")->DenseRange(3, 6);
+
+
+  static void BM_CompleteGeneratedTree(benchmark::State& state)
+  {
+    TreeGenerator generator(generatedConfig(state.range(0)));
+    auto root = generator.generate();
+
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(PathCompleter::complete(*root, "a", AccessLevel::User));
+    }
+  }
+  BENCHMARK(BM_CompleteGeneratedTree)->ArgName("depth")->DenseRange(3, 6);
+
+}
@@ -0,0 +1,103 @@
+#include "benchmark/benchmark.h"
+#include "BenchmarkTree.hpp"
+#include "cliService/tree/Path.hpp"
+#include "cliService/tree/PathResolver.hpp"
+#include "cliService/tree/PathCompleter.hpp"
+
+namespace cliService
+{
+
+  // Arguments: {depth, fanOut}
+  static void treeShapes(benchmark::internal::Benchmark* b)
+  {
+    b->ArgNames({"depth", "fanOut"});
+    b->ArgsProduct({{1, 3, 5}, {2, 4}});
+    b->Args({2, 16});
+    b->Args({2, 64});
+  }
+
+
+  static void BM_PathParse(benchmark::State& state)
+  {
+    const auto pathStr = deepestCommandPath(state.range(0), state.range(1));
+
+    for (auto _ : state) {
+      Path path(pathStr);
+      benchmark::DoNotOptimize(path);
+    }
+  }
+  BENCHMARK(BM_PathParse)->Apply(treeShapes);
+
+
+  static void BM_PathNormalize(benchmark::State& state)
+  {
+    // Every element is cancelled by a following ".." except the last one
+    std::string pathStr = "/";
+    for (int64_t i = 0; i < state.range(0); ++i) {
+      pathStr += "dir" + std::to_string(state.range(1) - 1) + "/./../";
+    }
+    pathStr += "cmd0";
+    const Path path(pathStr);
+
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(path.normalized());
+    }
+  }
+  BENCHMARK(BM_PathNormalize)->Apply(treeShapes);
+
+
+  static void BM_PathResolverResolve(benchmark::State& state)
+  {
+    auto root = buildTree(state.range(0), state.range(1));
+    PathResolver resolver(*root);
+    const Path path(deepestCommandPath(state.range(0), state.range(1)));
+
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(resolver.resolve(path, *root));
+    }
+  }
+  BENCHMARK(BM_PathResolverResolve)->Apply(treeShapes);
+
+
+  static void BM_PathResolverResolveFrozen(benchmark::State& state)
+  {
+    auto root = buildTree(state.range(0), state.range(1));
+    root->freeze();
+    PathResolver resolver(*root);
+    const Path path(deepestCommandPath(state.range(0), state.range(1)));
+
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(resolver.resolve(path, *root));
+    }
+  }
+  BENCHMARK(BM_PathResolverResolveFrozen)->Apply(treeShapes);
+
+
+  static void BM_DirectoryFindNode(benchmark::State& state)
+  {
+    auto root = buildTree(state.range(0), state.range(1));
+    auto elements = deepestDirectoryElements(state.range(0), state.range(1));
+    elements.push_back("cmd" + std::to_string(state.range(1) - 1));
+
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(root->findNode(elements));
+    }
+  }
+  BENCHMARK(BM_DirectoryFindNode)->Apply(treeShapes);
+
+
+  static void BM_PathCompleterComplete(benchmark::State& state)
+  {
+    auto root = buildTree(state.range(0), state.range(1));
+
+    // Completing "cm" inside the deepest directory matches every command there
+    auto input = deepestCommandPath(state.range(0), state.range(1));
+    input.erase(input.rfind('/') + 3);
+
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(PathCompleter::complete(*root, input, AccessLevel::User));
+    }
+  }
+  BENCHMARK(BM_PathCompleterComplete)->Apply(treeShapes);
+
+}
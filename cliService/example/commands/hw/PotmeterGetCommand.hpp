@@ -18,7 +18,10 @@ namespace cliService
       (void)description;
     }
 
-    CLIResponse execute(const std::vector<std::string>& args) override
+    CLIResponse execute(const std::vector<std::string>& args) override { return run(args); }
+
+    // Stateless, so the constant menu tree calls it without an instance
+    static CLIResponse run(const std::vector<std::string>& args)
     {
       if (args.size() != 1) {
         return CommandIf::createInvalidArgumentCountResponse(1);
@@ -48,7 +51,7 @@ namespace cliService
     }
 
   private:
-    uint32_t readPotmeter(uint32_t id) const
+    static uint32_t readPotmeter(uint32_t id)
     {
       uint32_t value = 0;
 
@@ -74,7 +77,7 @@ namespace cliService
       return value;
     }
 
-    float calcPotmeterPercentage(uint32_t value) const { return value / POTMETER_MAX * 100; }
+    static float calcPotmeterPercentage(uint32_t value) { return value / POTMETER_MAX * 100; }
     static constexpr uint32_t POTMETER_MAX = 1023;
   };
 
@@ -16,7 +16,10 @@ namespace cliService
       (void)description;
     }
 
-    CLIResponse execute(const std::vector<std::string>& args) override
+    CLIResponse execute(const std::vector<std::string>& args) override { return run(args); }
+
+    // Stateless, so the constant menu tree calls it without an instance
+    static CLIResponse run(const std::vector<std::string>& args)
     {
       if (args.size() != 4) {
         return CommandIf::createInvalidArgumentCountResponse(4);
@@ -49,7 +52,7 @@ namespace cliService
     }
 
   private:
-    bool isValidValueString(const std::string& str)
+    static bool isValidValueString(const std::string& str)
     {
       if (str.empty() || str.length() > 3) return false;
       
@@ -69,7 +72,7 @@ namespace cliService
       return true;
     }
 
-    void setRgbLed(uint32_t id, std::array<uint8_t, 3> rgbValues) const
+    static void setRgbLed(uint32_t id, std::array<uint8_t, 3> rgbValues)
     {
       (void)id;
       (void)rgbValues;
@@ -22,7 +22,10 @@ namespace cliService
       (void)description;
     }
 
-    CLIResponse execute(const std::vector<std::string>& args) override
+    CLIResponse execute(const std::vector<std::string>& args) override { return run(args); }
+
+    // Stateless, so the constant menu tree calls it without an instance
+    static CLIResponse run(const std::vector<std::string>& args)
     {
       if (args.size() != 1) {
         return CommandIf::createInvalidArgumentCountResponse(1);
@@ -43,7 +46,7 @@ namespace cliService
     }
 
   private:
-    std::string posToString(ToggleSwitchPosition pos) const
+    static std::string posToString(ToggleSwitchPosition pos)
     {
       switch (pos)
       {
@@ -58,7 +61,7 @@ namespace cliService
       }
     }
 
-    ToggleSwitchPosition readToggleSwitchPosition(uint32_t id) const
+    static ToggleSwitchPosition readToggleSwitchPosition(uint32_t id)
     {
       ToggleSwitchPosition pos{};
 
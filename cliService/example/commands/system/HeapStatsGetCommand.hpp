@@ -14,7 +14,10 @@ namespace cliService
       (void)description;
     }
 
-    CLIResponse execute(const std::vector<std::string>& args) override
+    CLIResponse execute(const std::vector<std::string>& args) override { return run(args); }
+
+    // Stateless, so the constant menu tree calls it without an instance
+    static CLIResponse run(const std::vector<std::string>& args)
     {
       if (args.size() != 0) {
         return CommandIf::createInvalidArgumentCountResponse(0);
@@ -1,8 +1,10 @@
 #include "cliService/cli/CLIService.hpp"
 #include "io/UnixWinCharIOStream.hpp"
 #include "commands/AccessLevel.hpp"
+#include "menuTree/constMenuTree.hpp"
 #include "menuTree/staticMenuTree.hpp"
 #include "menuTree/mixedMenuTree.hpp"
+#include <cstdio>
 #include <vector>
 #include <thread>
 #include <chrono>
@@ -12,9 +14,33 @@ constexpr uint32_t inputTimeout_ms = 1000;
 
 using namespace cliService;
 
+// Runs one command from the compile-time tree, e.g. "hw/pot/get 1", as a user
+static CLIResponse executeConstCommand(std::string_view path, const std::vector<std::string>& args)
+{
+  const ConstNodeIndex index = CONST_MENU_TREE.resolve(path);
+
+  if (index == ConstTree::INVALID) {
+    return CLIResponse("Invalid path: " + std::string(path), CLIResponse::Status::InvalidPath);
+  }
+
+  if (!CONST_MENU_TREE.isAccessible(index, AccessLevel::User)) {
+    return CLIResponse("Access denied: " + CONST_MENU_TREE.getAbsolutePath(index), CLIResponse::Status::AccessDenied);
+  }
+
+  return CONST_MENU_TREE.execute(index, args);
+}
+
 // Example usage in main
-int main()
+int main(int argc, char* argv[])
 {
+  // Arguments run a single command from the constant tree instead of a session
+  if (argc > 1)
+  {
+    const CLIResponse response = executeConstCommand(argv[1], std::vector<std::string>(argv + 2, argv + argc));
+    std::printf("%s\n", response.getMessage().c_str());
+    return response.getStatus() == CLIResponse::Status::Success ? 0 : 1;
+  }
+
   UnixWinCharIOStream ioStream{};
 
   std::vector<User> users
@@ -25,6 +51,7 @@ int main()
 
   StaticMenuTree staticTree;  // Using fully static allocation of menu tree
   auto mixedTree = createMixedMenuTree();  // OR using mixed allocation
+  mixedTree->freeze();  // Tree is complete - compact it for faster lookups
   
   CLIServiceConfiguration staticConfig
   {
@@ -43,6 +70,7 @@ int main()
     inputTimeout_ms,
     commandHistorySize
   };
+  mixedConfig._pageHeight = 20;  // Page outputs longer than a screen
 
   // Create service with static or mixed configuration
   CLIService cli(std::move(mixedConfig));
@@ -0,0 +1,45 @@
+#pragma once
+#include "cliService/tree/ConstTree.hpp"
+#include "commands/AccessLevel.hpp"
+#include "commands/system/RebootCommand.hpp"
+#include "commands/system/HeapStatsGetCommand.hpp"
+#include "commands/hw/RgbLedSetCommand.hpp"
+#include "commands/hw/PotmeterGetCommand.hpp"
+#include "commands/hw/ToggleSwitchGetCommand.hpp"
+
+using namespace cliService;
+
+// Example of a compile-time menu tree. Same layout as StaticMenuTree, but the
+// whole table is constexpr and ends up in read-only memory. Commands are plain
+// functions, nothing is constructed when one runs.
+//
+//  idx  node       parent  children
+//   0   root/        -     1..2
+//   1   system/      0     3..4
+//   2   hw/          0     5..7
+//   3   reboot       1
+//   4   heap         1
+//   5   pot/         2     8
+//   6   rgb/         2     9
+//   7   toggle/      2     10
+//   8   get          5
+//   9   set          6
+//  10   get          7
+inline constexpr ConstNode CONST_MENU_NODES[] = {
+  ConstTree::directory("root",   AccessLevel::User,  ConstTree::INVALID, 1, 2),
+  ConstTree::directory("system", AccessLevel::Admin, 0, 3, 2),
+  ConstTree::directory("hw",     AccessLevel::User,  0, 5, 3),
+  ConstTree::command("reboot", AccessLevel::Admin, 1, &RebootCommand::run, "Reboot the device"),
+  ConstTree::command("heap",   AccessLevel::Admin, 1, &HeapStatsGetCommand::run, "List FreeRTOS heap statistics"),
+  ConstTree::directory("pot",    AccessLevel::User,  2, 8, 1),
+  ConstTree::directory("rgb",    AccessLevel::User,  2, 9, 1),
+  ConstTree::directory("toggle", AccessLevel::User,  2, 10, 1),
+  ConstTree::command("get", AccessLevel::User,  5, &PotmeterGetCommand::run, "Get potmeter value - Args: <pot ID>"),
+  ConstTree::command("set", AccessLevel::Admin, 6, &RgbLedSetCommand::run, "Set RGB LED color - Args: <rgbLED ID> <R> <G> <B>"),
+  ConstTree::command("get", AccessLevel::User,  7, &ToggleSwitchGetCommand::run, "Get toggle switch position - Args: <toggleSwitch ID>"),
+};
+
+inline constexpr ConstTree CONST_MENU_TREE{CONST_MENU_NODES};
+
+static_assert(CONST_MENU_TREE.isValid(), "Malformed constant menu tree");
+static_assert(CONST_MENU_TREE.resolve("/hw/rgb/set") == 9, "Lookup is evaluated at compile time");
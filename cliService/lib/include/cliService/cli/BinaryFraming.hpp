@@ -0,0 +1,73 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cliService
+{
+
+  // Compact framing for low-bandwidth links. Commands are addressed by node
+  // ID instead of path, all integers are unsigned LEB128 varints (7 bits per
+  // byte, least significant first, high bit set on all but the last byte):
+  //
+  //   Request:  <frame length> <node id> <argc> { <arg length> <arg bytes> }
+  //   Response: <status byte> <body length> <body bytes>
+  //
+  // The frame length counts the bytes following it. Lengths above
+  // MAX_FRAME_LENGTH are rejected at once, the byte after them is read as
+  // the next frame length. A zero length frame is ignored. Padding cannot
+  // resynchronize: any bytes may complete a pending frame into a valid
+  // request. Instead the service drops a frame left incomplete for longer
+  // than the input timeout (see reset()), so a client that lost sync pauses
+  // that long and its next request starts on a frame boundary.
+  class BinaryFrameDecoder
+  {
+  public:
+    static constexpr size_t MAX_FRAME_LENGTH = 256;
+    static constexpr size_t MAX_VARINT_LENGTH = 5;  // Enough for 32 bits
+
+    enum class Result
+    {
+      Incomplete,  // Feed more bytes
+      Complete,    // getNodeId() and getArgs() hold the request
+      Malformed    // Frame dropped, the next byte starts a new frame
+    };
+
+    BinaryFrameDecoder();
+
+    Result push(char c);
+
+    // Part of a frame was read, including its length
+    bool isPending() const { return _lengthBytes > 0; }
+
+    // Drop a pending frame, the next byte starts a new one
+    void reset();
+
+    uint32_t getNodeId() const { return _nodeId; }
+    const std::vector<std::string>& getArgs() const { return _args; }
+
+    // Write 'value' to 'out' (room for MAX_VARINT_LENGTH bytes), returns the bytes used
+    static size_t encodeVarint(uint32_t value, char* out);
+    static void appendVarint(uint32_t value, std::string& out);
+
+    // Read a varint from the front of 'in', false if it is truncated or too long
+    static bool readVarint(std::string_view& in, uint32_t& value);
+
+  private:
+    bool decodeFrame();
+
+    std::string _frame;           // Payload bytes, reserved up front
+    uint32_t _frameLength = 0;
+    size_t _lengthBytes = 0;      // Varint bytes of the frame length read so far
+    bool _haveLength = false;
+
+    uint32_t _nodeId = 0;
+    std::vector<std::string> _args;  // Reused, so steady traffic does not allocate
+  };
+
+  // Append a request frame to 'out', for clients and tests
+  void encodeBinaryRequest(uint32_t nodeId, const std::vector<std::string>& args, std::string& out);
+
+}
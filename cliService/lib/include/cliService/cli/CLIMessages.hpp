@@ -19,6 +19,7 @@ namespace cliService
     void setAccessDeniedMessage(std::string msg) { _accessDeniedMessage = std::move(msg); }
     void setInvalidPathMessage(std::string msg) { _invalidPathMessage = std::move(msg); }
     void setInvalidLoginMessage(std::string msg) { _invalidLoginMessage = std::move(msg); }
+    void setMorePrompt(std::string msg) { _morePrompt = std::move(msg); }
     void setIndentation(std::string msg) { _indentation = std::move(msg); }
     void setNewLine(std::string msg) { _newLine = std::move(msg); }
 
@@ -31,6 +32,7 @@ namespace cliService
     std::string_view getAccessDeniedMessage() const { return _accessDeniedMessage; }
     std::string_view getInvalidPathMessage() const { return _invalidPathMessage; }
     std::string_view getInvalidLoginMessage() const { return _invalidLoginMessage; }
+    std::string_view getMorePrompt() const { return _morePrompt; }
     std::string_view getIndentation() const { return _indentation; }
 
     std::string getNewLine(uint32_t count = 1) const
@@ -57,6 +59,7 @@ namespace cliService
       messages.setAccessDeniedMessage("Access denied");
       messages.setInvalidPathMessage("Invalid path");
       messages.setInvalidLoginMessage("Invalid login attempt. Please enter <username>:<password>");
+      messages.setMorePrompt("-- More -- (space: next page, enter: next line, q: quit)");
       messages.setIndentation("  ");
       messages.setNewLine("\r\n");
       return messages;
@@ -71,6 +74,7 @@ namespace cliService
     std::string _accessDeniedMessage;
     std::string _invalidPathMessage;
     std::string _invalidLoginMessage;
+    std::string _morePrompt;
     std::string _indentation;
     std::string _newLine;
   };
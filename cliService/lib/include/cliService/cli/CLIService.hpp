@@ -1,11 +1,18 @@
 #pragma once
+#include "cliService/cli/BinaryFraming.hpp"
 #include "cliService/cli/CLIServiceConfiguration.hpp"
 #include "cliService/cli/CLIState.hpp"
 #include "cliService/cli/CommandHistory.hpp"
 #include "cliService/cli/InputParser.hpp"
+#include "cliService/cli/JobTable.hpp"
+#include "cliService/cli/LatencyStats.hpp"
+#include "cliService/cli/TxScheduler.hpp"
+#include "cliService/cli/WatchView.hpp"
 #include "cliService/tree/Directory.hpp"
+#include "cliService/tree/OutputFilter.hpp"
 #include "cliService/tree/Path.hpp"
 #include "cliService/tree/PathResolver.hpp"
+#include <limits>
 #include <optional>
 #include <unordered_set>
 
@@ -23,6 +30,24 @@ namespace cliService
     CLIResponse handleRequest(const RequestBase& request);
     CLIState getCLIState() const { return _currentCLIState; }
 
+    // Metrics of every command invoked at least once, in tree order
+    std::vector<CommandMetricsSnapshot> getMetricsSnapshot() const;
+    void resetMetrics();
+
+    // Run command lines as the logged in user, through the same resolve,
+    // authorize and execute path as typed commands but without the input
+    // parser, history or paging
+    ScriptResult runScript(std::string_view script, const ScriptOptions& options = ScriptOptions());
+
+    // Output pacing and queue depths
+    const TxScheduler& getTxScheduler() const { return _txScheduler; }
+
+#if CLISERVICE_LATENCY_STATS
+    // Keystroke to echo/response latencies of this session
+    const LatencyStats& getLatencyStats() const { return _latencyStats; }
+    void resetLatencyStats() { _latencyStats.reset(); }
+#endif
+
   protected:
 
     enum class NodeDisplayMode {
@@ -31,17 +56,25 @@ namespace cliService
     };
 
     NodeIf* resolvePath(const Path& path) const;
+    static std::optional<uint32_t> parseNodeId(const Path& path);
     bool validatePathAccess(const NodeIf* node) const;
 
     void resetToRoot();
+    void clearSessionState();
 
-    std::string getPromptString() const;
+    const std::string& getPromptString() const;
 
     std::string formatNodeInfo(const NodeIf& node, const std::string& indent, bool showCmdDescription) const;
     std::string getNodeListDisplay(NodeDisplayMode mode, bool showCmdDescription) const;
+    std::string renderNodeListDisplay(NodeDisplayMode mode, bool showCmdDescription) const;
+    std::vector<CommandMetricsSnapshot> collectMetrics(std::optional<AccessLevel> maxLevel) const;
+    void resetMetrics(std::optional<AccessLevel> maxLevel);
+    std::string formatMetrics(const std::vector<CommandMetricsSnapshot>& snapshot, std::string_view title) const;
 
   private:
     Directory* getRootPtr() const;
+    bool serviceNextRequest();
+    bool serviceNextFrame();
 
     // Request handlers
     CLIResponse handleRequest(const InvalidLoginRequest& request);
@@ -49,28 +82,119 @@ namespace cliService
     CLIResponse handleRequest(const CommandRequest& request);
     CLIResponse handleRequest(const TabCompletionRequest& request);
     CLIResponse handleRequest(const HistoryNavigationRequest& request);
+    CLIResponse handleRequest(const PagerRequest& request);
+    CLIResponse rejectLogin(const std::string* username);
+    bool isLoginThrottled() const;
+    bool holdLogin(std::unique_ptr<RequestBase>& request);
+    CLIResponse handleBinaryRequest(uint32_t nodeId, const std::vector<std::string>& args);
+    CLIResponse executeCommand(CommandIf& cmd, const std::vector<std::string>& args);
+    void applyOutputFilters(CLIResponse& response, const std::vector<OutputFilter>& filters) const;
+    CLIResponse startJob(const CommandRequest& request, const std::vector<OutputFilter>& filters);
 
     // Global command handlers
     CLIResponse handleGlobalCommand(const std::string_view& command, const std::vector<std::string>& args);
     CLIResponse handleGlobalLogout(const std::vector<std::string>& args);
     CLIResponse handleGlobalExit(const std::vector<std::string>& args);
     CLIResponse handleGlobalTree(const std::vector<std::string>& args);
+    static bool parseDepth(std::string_view text, size_t& depth);
     CLIResponse handleGlobalHelp(const std::vector<std::string>& args);
     CLIResponse handleGlobalQuestionMark(const std::vector<std::string>& args);
     CLIResponse handleGlobalClear(const std::vector<std::string>& args);
+    CLIResponse handleGlobalStats(const std::vector<std::string>& args);
+    CLIResponse handleGlobalMode(const std::vector<std::string>& args);
+    CLIResponse handleGlobalSource(const std::vector<std::string>& args);
+    CLIResponse handleGlobalWatch(const std::vector<std::string>& args);
+    CLIResponse handleGlobalJobs(const std::vector<std::string>& args);
+    CLIResponse handleGlobalFg(const std::vector<std::string>& args);
+    static bool parseInterval(std::string_view text, uint64_t& interval_ms);
+
+    // Watch, driven by service() instead of the input parser
+    void serviceWatch();
+    void refreshWatch();
+    void stopWatch();
+
+    void handleOutput(const CLIResponse& response, bool allowDeferral = true);
+    void finishOutput(const CLIResponse& response);
+    void writeFrame(const CLIResponse& response);
+    void writeBinaryFrame(const CLIResponse& response);
+    std::string_view collectResponseBody(const CLIResponse& response);
+    void writeOutput(std::string_view text);
+    void flushOutput();
+
+    // Pager, also resumes output held back by TX pacing
+    void writePage(size_t lineCount);
+    void continueOutput();
+    bool hasOutputSpace() const;
+    bool isDrainingOutput() const { return _pagedOutput && !_inputParser.isPagerMode(); }
+    bool nextPagedLine();
+    void endPaging();
 
-    void handleOutput(const CLIResponse& response);
-    std::vector<std::string> splitString(const std::string& str, const std::string& delimiter);
+    // Next line of 'message' split at 'newLine', offset is npos once done
+    static bool nextMessageLine(const std::string& message, size_t& offset, std::string_view newLine, std::string_view& line);
+
+#if CLISERVICE_LATENCY_STATS
+    void recordLatency(const RequestBase& request);
+#endif
 
     CharIOStreamIf& _ioStream;
+
+    SteadyClock _defaultClock;
+    const ClockIf& _clock;
+
+    TxScheduler _txScheduler;
+    TxChannel _interactiveStream;  // Echo goes ahead of queued command output
     InputParser _inputParser;
 
+    // Output is staged here and written to the stream whenever it fills up
+    static constexpr size_t OUTPUT_BUFFER_CAPACITY = 256;
+    std::string _outputBuffer;
+    std::string _lineBuffer;  // Reused for lines pulled from output sources
+
+    // Machine mode frames every response as "<status> <length>" plus the
+    // body, with streamed lines collected first to know the length
+    bool _machineMode;
+    std::string _frameBuffer;
+
+    // Binary mode replaces the input parser by a frame decoder, addressing
+    // commands by node ID. Addressing the root (ID 0) leaves it again.
+    static constexpr uint32_t LEAVE_BINARY_MODE_ID = 0;
+    bool _binaryMode = false;
+    BinaryFrameDecoder _binaryDecoder;
+    const uint64_t _frameTimeout_us;  // Silence dropping a pending frame, the input timeout
+    uint64_t _lastFrameRead_us = 0;
+
+    // Response being shown page by page, only pulled further on key presses
+    // or, when paced, as the TX queue drains
+    struct PagedOutput
+    {
+      CLIResponse response;
+      size_t messageOffset = 0;
+      bool hasLookahead = false;  // Next line already waits in _lineBuffer
+      size_t linesLeft = 0;       // Until the more prompt, UNLIMITED_LINES without pager
+      bool typedAhead = false;    // Input was echoed in between the output
+    };
+
+    static constexpr size_t UNLIMITED_LINES = std::numeric_limits<size_t>::max();
+
+    const size_t _pageHeight;
+    std::optional<PagedOutput> _pagedOutput;
+    std::unique_ptr<RequestBase> _deferredRequest;  // Arrived while output was still draining
+    const size_t _maxRequestsPerService;
+
     CommandHistory _commandHistory;
     std::string _savedBuffer;  // For saving current input during history navigation
 
-    std::vector<User> _users;
+    UserStore _defaultUserStore;  // Built from CLIServiceConfiguration::_users
+    const UserStore& _userStore;
     std::optional<User> _currentUser;
 
+    // Failed logins back off exponentially, per session and per username.
+    // While the session waits its input is left unread.
+    LoginThrottle _defaultLoginThrottle;
+    LoginThrottle& _loginThrottle;
+    LoginThrottle::Backoff _loginBackoff;
+    bool _loginHeld = false;  // _deferredRequest is a login held until its name's wait was over
+
     std::variant<Directory*, std::unique_ptr<Directory>> _rootDirectory;
     Directory* _currentDirectory;
     PathResolver _pathResolver;
@@ -78,6 +202,58 @@ namespace cliService
     CLIState _currentCLIState;
     const CLIMessages _messages;
 
+    // Cached, keyed by the ID of the current directory
+    mutable std::string _prompt;
+    mutable uint32_t _promptDirectoryId = NodeIf::INVALID_ID;
+    mutable bool _promptValid = false;
+
+    TracerIf* _tracer;
+
+#if CLISERVICE_LATENCY_STATS
+    LatencyStats _latencyStats;
+#endif
+
+    static constexpr size_t MAX_TREE_DEPTH = 1000;  // Largest accepted 'tree -L' value
+
+    // Scripts may source other scripts, up to this depth
+    static constexpr size_t MAX_SCRIPT_DEPTH = 4;
+    ScriptLoaderIf* _scriptLoader;
+    const std::optional<AccessLevel> _scriptAccessLevel;
+    size_t _scriptDepth = 0;
+
+    // Command rerun by 'watch' on a timer, its lines redrawn differentially
+    // below a header
+    struct WatchState
+    {
+      // First run is due at once
+      WatchState(CommandIf* watched, std::vector<std::string> watchedArgs, uint64_t period_us, uint64_t now_us)
+        : command(watched), args(std::move(watchedArgs)), interval_us(period_us), nextRun_us(now_us)
+        , view(WATCH_HEADER_ROWS + 1)
+      {
+      }
+
+      CommandIf* command;
+      std::vector<std::string> args;
+      std::vector<OutputFilter> filters;
+      uint64_t interval_us;
+      uint64_t nextRun_us;
+      WatchView view;
+      std::vector<std::string> lines;  // Reused across refreshes
+      std::string output;
+      bool skipLineFeed = false;  // Of the CR LF that started it, not a key press
+    };
+
+    static constexpr size_t WATCH_HEADER_ROWS = 2;     // Header and a blank line
+    static constexpr size_t MAX_WATCH_LINES = 100;     // Without a page height
+    static constexpr uint64_t DEFAULT_WATCH_INTERVAL_MS = 2000;
+    static constexpr uint64_t MIN_WATCH_INTERVAL_MS = 100;
+    static constexpr uint64_t MAX_WATCH_INTERVAL_MS = 86400000;
+    std::optional<WatchState> _watch;
+
+    // Background jobs, each producing this many lines per service() call
+    static constexpr size_t JOB_LINES_PER_SERVICE = 8;
+    JobTable _jobs;
+
     using GlobalCommandHandler = CLIResponse (CLIService::*)(const std::vector<std::string>&);
     static const std::unordered_map<std::string_view, GlobalCommandHandler> GLOBAL_COMMAND_HANDLERS;
   };
@@ -2,9 +2,15 @@
 #include "cliService/cli/User.hpp"
 #include "cliService/cli/CharIOStreamIf.hpp"
 #include "cliService/cli/CLIMessages.hpp"
+#include "cliService/cli/ClockIf.hpp"
+#include "cliService/cli/LoginThrottle.hpp"
+#include "cliService/cli/Script.hpp"
+#include "cliService/cli/TracerIf.hpp"
+#include "cliService/cli/UserStore.hpp"
 #include "cliService/tree/Directory.hpp"
 #include <vector>
 #include <memory>
+#include <optional>
 #include <variant>
 
 namespace cliService
@@ -51,6 +57,22 @@ namespace cliService
     uint32_t _inputTimeout_ms;
     size_t _historySize;
     CLIMessages _messages;
+    ClockIf* _clock = nullptr;  // Optional, defaults to std::chrono::steady_clock
+    TracerIf* _tracer = nullptr;  // Optional, no tracing by default
+    size_t _pageHeight = 0;       // Lines per page of long outputs, 0 disables the pager
+    uint32_t _txBytesPerSecond = 0;  // Output pacing (e.g. 11520 for 115200 baud 8N1), 0 writes unpaced
+    size_t _txQueueCapacity = 2048;  // Bytes of command output queued ahead of the link when paced
+    bool _machineMode = false;       // Start in machine mode: no echo or prompts, framed responses
+    size_t _maxRequestsPerService = 16;  // Buffered requests handled back to back by one service() call
+    ScriptLoaderIf* _scriptLoader = nullptr;  // Optional, enables the 'source' command
+    std::optional<AccessLevel> _scriptAccessLevel;  // Lowest level allowed to 'source', every user if unset
+    size_t _jobOutputCapacity = 1024;  // Bytes of output buffered per background job
+    uint32_t _passwordIterations = UserStore::DEFAULT_ITERATIONS;  // PBKDF2 work factor for hashing _users
+    uint64_t _saltSeed = 0;  // Salts of _users derive from it and the clock, e.g. a serial number or hardware RNG word
+    const UserStore* _userStore = nullptr;  // Optional, provisioned accounts used instead of _users
+    uint64_t _loginBackoff_ms = LoginThrottle::DEFAULT_BASE_DELAY_MS;     // First wait after repeated failed logins, 0 disables
+    uint64_t _maxLoginBackoff_ms = LoginThrottle::DEFAULT_MAX_DELAY_MS;   // Cap of the doubling wait
+    LoginThrottle* _loginThrottle = nullptr;  // Optional, shared by sessions to throttle per username across them
   };
 
 }
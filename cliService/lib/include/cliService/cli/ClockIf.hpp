@@ -0,0 +1,28 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+
+namespace cliService
+{
+
+  // Monotonic time source. Targets without std::chrono support (or tests)
+  // pass their own implementation through CLIServiceConfiguration.
+  class ClockIf
+  {
+  public:
+    virtual ~ClockIf() = default;
+
+    virtual uint64_t now_us() const = 0;
+  };
+
+  class SteadyClock : public ClockIf
+  {
+  public:
+    uint64_t now_us() const override
+    {
+      auto elapsed = std::chrono::steady_clock::now().time_since_epoch();
+      return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+    }
+  };
+
+}
@@ -14,26 +14,37 @@ namespace cliService
   class CommandRequest : public RequestBase
   {
   public:
-    explicit CommandRequest(Path path, std::vector<std::string> args, std::string originalInput)
+    // Words of each '| filter' stage following the command
+    using Filters = std::vector<std::vector<std::string>>;
+
+    explicit CommandRequest(Path path, std::vector<std::string> args, std::string originalInput, Filters filters = {}, bool background = false)
       : _path(std::move(path))
       , _args(std::move(args))
       , _originalInput(std::move(originalInput))
+      , _filters(std::move(filters))
+      , _background(background)
     {}
 
-    explicit CommandRequest(Path path, std::vector<std::string> args, std::string_view originalInput)
+    explicit CommandRequest(Path path, std::vector<std::string> args, std::string_view originalInput, Filters filters = {}, bool background = false)
       : _path(std::move(path))
       , _args(std::move(args))
       , _originalInput(std::string(originalInput))
+      , _filters(std::move(filters))
+      , _background(background)
     {}
 
     const Path& getPath() const { return _path; }
     const std::vector<std::string>& getArgs() const { return _args; }
     const std::string& getOriginalInput() const { return _originalInput; }
+    const Filters& getFilters() const { return _filters; }
+    bool isBackground() const { return _background; }  // Line ended in '&'
 
   private:
     Path _path;
     std::vector<std::string> _args;
     std::string _originalInput;
+    Filters _filters;
+    bool _background;
   };
 
 }
@@ -0,0 +1,27 @@
+#pragma once
+#include "cliService/cli/Script.hpp"
+#include <string>
+#include <string_view>
+
+namespace cliService
+{
+
+  // Reads scripts from files below 'baseDirectory'. Names are relative
+  // paths, absolute ones and ".." elements are refused so 'source' cannot
+  // reach files elsewhere. Symbolic links below the base are followed.
+  // Needs host file I/O, so CLIServiceConfiguration does not pull it in.
+  class FileScriptLoader : public ScriptLoaderIf
+  {
+  public:
+    explicit FileScriptLoader(std::string baseDirectory);
+
+    bool load(std::string_view name, std::string& content) override;
+
+    // Relative to the base directory and staying below it
+    static bool isConfined(std::string_view name);
+
+  private:
+    std::string _baseDirectory;
+  };
+
+}
@@ -4,7 +4,11 @@
 #include "cliService/cli/LoginRequest.hpp"
 #include "cliService/cli/TabCompletionRequest.hpp"
 #include "cliService/cli/HistoryNavigationRequest.hpp"
+#include "cliService/cli/PagerRequest.hpp"
 #include "cliService/cli/CLIState.hpp"
+#include "cliService/cli/ClockIf.hpp"
+#include "cliService/cli/LatencyStats.hpp"
+#include "cliService/cli/TracerIf.hpp"
 #include <memory>
 #include <string>
 #include <optional>
@@ -16,6 +20,7 @@ namespace cliService
   {
   public:
     static constexpr size_t MAX_ESCAPE_LENGTH = 16;
+    static constexpr size_t LINE_BUFFER_CAPACITY = 128;  // Reserved up front, so typing doesn't allocate
 
     static constexpr char BACKSPACE_DEL = 0x7F;  // ASCII DEL
     static constexpr char BACKSPACE_BS = 0x08;   // ASCII backspace
@@ -36,6 +41,8 @@ namespace cliService
     {
       Path path;
       std::vector<std::string> args;
+      CommandRequest::Filters filters;  // 'command args | filter args | ...'
+      bool background = false;          // Trailing '&'
     };
 
     InputParser(CharIOStreamIf& ioStream, const CLIState& cliState, uint32_t inputTimeout_ms);
@@ -43,9 +50,31 @@ namespace cliService
     std::optional<std::unique_ptr<RequestBase>> getNextRequest();
 
     std::string getBuffer() const { return _buffer; }
+
+    // The last character read was a CR, a line feed still to come belongs to the same Enter
+    bool endedWithCr() const { return _previousChar == ENTER_CR; }
     void replaceBuffer(const std::string& newContent, bool display = true);
     void appendToBuffer(const std::string& newConatent$, bool display = true);
 
+    // While paging, keys are turned into PagerRequests instead of editing the line
+    void setPagerMode(bool enabled) { _pagerMode = enabled; }
+    bool isPagerMode() const { return _pagerMode; }
+
+    // Machine mode: nothing is echoed, Tab and arrow keys are ignored
+    void setMachineMode(bool enabled) { _machineMode = enabled; }
+    bool isMachineMode() const { return _machineMode; }
+
+    // Report the parse phase of every request, nullptr disables tracing
+    void setTracer(TracerIf* tracer, const ClockIf& clock);
+
+#if CLISERVICE_LATENCY_STATS
+    // Time stamp incoming bytes and record the echo latency of regular characters
+    void setLatencyProbe(const ClockIf& clock, LatencyStats& stats);
+
+    // Receipt time of the first byte of the input that completed the last request
+    uint64_t getRequestReceivedAt_us() const { return _receivedAt_us; }
+#endif
+
     static ParsedPathAndArgs parseToPathAndArgs(std::string_view input);
     static std::optional<LoginRequest> parseToLoginRequest(const std::string& input);
     static std::unique_ptr<CommandRequest> parseToCommandRequest(std::string_view input);
@@ -56,6 +85,7 @@ namespace cliService
     bool processNextChar();
     std::optional<std::unique_ptr<RequestBase>> createRequest();
 
+    bool handlePagerKey(char c);
     bool handleControlCharacter(char c);
     bool handleEscapeSequence();
     void handleRegularCharacter(char c);
@@ -73,6 +103,20 @@ namespace cliService
     size_t _escapeIndex;
 
     ActionTrigger _trigger;
+    char _previousChar = '\0';
+
+    bool _pagerMode = false;
+    bool _machineMode = false;
+    PagerRequest::Action _pagerAction = PagerRequest::Action::NextPage;
+
+    TracerIf* _tracer = nullptr;
+    const ClockIf* _tracerClock = nullptr;
+
+#if CLISERVICE_LATENCY_STATS
+    const ClockIf* _latencyClock = nullptr;
+    LatencyStats* _latencyStats = nullptr;
+    uint64_t _receivedAt_us = 0;
+#endif
   };
 
 }
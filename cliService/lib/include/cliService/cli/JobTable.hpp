@@ -0,0 +1,98 @@
+#pragma once
+#include "cliService/tree/CLIResponse.hpp"
+#include "cliService/tree/OutputSourceIf.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace cliService
+{
+
+  // Runs the command of a job and sets its status, returns the lines of its response
+  using JobStart = std::function<std::shared_ptr<OutputSourceIf>(CLIResponse::Status& status)>;
+
+  // Command started with a trailing '&'. It is started on its first turn in
+  // the service loop, after the prompt is back; the lines of its response
+  // (usually a lazy OutputSourceIf) are then pulled a few at a time into a
+  // buffer of bounded size. Once the buffer is full the oldest lines are
+  // dropped and counted. Work done in execute() itself still happens in one
+  // go, commands do theirs in the returned OutputSourceIf to keep every
+  // turn short.
+  class BackgroundJob
+  {
+  public:
+    static constexpr size_t LINE_OVERHEAD = 2;  // Charged per line (its line break), empty lines are not free
+    static constexpr size_t MAX_LINES = 256;    // Buffered lines, whatever their length
+
+    BackgroundJob(uint32_t id, std::string commandLine, CLIResponse::Status status,
+                  std::shared_ptr<OutputSourceIf> source, size_t capacity);
+    BackgroundJob(uint32_t id, std::string commandLine, JobStart start, size_t capacity);
+
+    // Pull up to 'maxLines' lines, returns false once the job is done
+    bool pull(size_t maxLines);
+
+    uint32_t getId() const { return _id; }
+    const std::string& getCommandLine() const { return _commandLine; }
+    CLIResponse::Status getStatus() const { return _status; }
+    bool isRunning() const { return _start || _source; }
+
+    size_t getBufferedLines() const { return _lines.size(); }
+    size_t getBufferedBytes() const { return _bufferedBytes; }
+    size_t getDroppedLines() const { return _droppedLines; }
+
+    // Buffered lines, preceded by a note on dropped ones, followed by
+    // whatever the job has not produced yet. A job not started yet is
+    // started first. Leaves the job empty.
+    std::shared_ptr<OutputSourceIf> takeOutput();
+
+  private:
+    void begin();
+    void store(std::string& line);
+
+    uint32_t _id;
+    std::string _commandLine;
+    CLIResponse::Status _status;
+    JobStart _start;                          // Empty once started
+    std::shared_ptr<OutputSourceIf> _source;  // nullptr once done
+
+    size_t _capacity;  // Bytes of buffered lines, LINE_OVERHEAD included
+    std::deque<std::string> _lines;
+    size_t _bufferedBytes = 0;
+    size_t _droppedLines = 0;
+  };
+
+  // Jobs of the session, numbered from 1 like in a shell
+  class JobTable
+  {
+  public:
+    static constexpr size_t MAX_JOBS = 4;
+
+    explicit JobTable(size_t outputCapacity)
+      : _outputCapacity(outputCapacity)
+    {}
+
+    // nullptr when MAX_JOBS are kept already
+    BackgroundJob* start(std::string commandLine, CLIResponse::Status status, std::shared_ptr<OutputSourceIf> source);
+    BackgroundJob* start(std::string commandLine, JobStart start);
+
+    // Let every running job produce up to 'maxLines' lines
+    void service(size_t maxLines);
+
+    BackgroundJob* find(uint32_t id);
+    BackgroundJob* latest() { return _jobs.empty() ? nullptr : &_jobs.back(); }
+    void remove(uint32_t id);
+    void clear() { _jobs.clear(); }
+
+    bool isRunning() const;
+    const std::vector<BackgroundJob>& getJobs() const { return _jobs; }
+
+  private:
+    const size_t _outputCapacity;
+    std::vector<BackgroundJob> _jobs;  // By ascending ID
+  };
+
+}
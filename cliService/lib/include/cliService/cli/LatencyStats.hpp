@@ -0,0 +1,58 @@
+#pragma once
+#include "cliService/tree/CommandMetrics.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Keystroke latency instrumentation is compiled in only when the build
+// defines CLISERVICE_LATENCY_STATS=1 (CMake option of the same name).
+#ifndef CLISERVICE_LATENCY_STATS
+#define CLISERVICE_LATENCY_STATS 0
+#endif
+
+namespace cliService
+{
+
+  // Time from receiving the byte that completes an input until its echo or
+  // response has been written, aggregated per kind of input
+  class LatencyStats
+  {
+  public:
+    enum class Kind : uint8_t
+    {
+      CharEcho,
+      Tab,
+      History,
+      Command,
+      Count
+    };
+
+    static constexpr size_t KIND_COUNT = static_cast<size_t>(Kind::Count);
+
+    void record(Kind kind, uint64_t latency_us) { _stats[index(kind)].record(latency_us, false); }
+
+    // Invocations are the number of samples, percentiles come from the histogram
+    const CommandMetrics& get(Kind kind) const { return _stats[index(kind)]; }
+
+    void reset() { _stats = {}; }
+
+    static const char* getName(Kind kind)
+    {
+      switch (kind)
+      {
+        case Kind::CharEcho: return "echo";
+        case Kind::Tab:      return "tab";
+        case Kind::History:  return "history";
+        case Kind::Command:  return "command";
+        case Kind::Count:
+        default:             return "?";
+      }
+    }
+
+  private:
+    static size_t index(Kind kind) { return static_cast<size_t>(kind); }
+
+    std::array<CommandMetrics, KIND_COUNT> _stats{};
+  };
+
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+namespace cliService
+{
+
+  // Exponential backoff after failed logins. The first FREE_FAILURES
+  // failures cost nothing, every further one doubles the wait, up to the
+  // maximum delay. A session keeps its own Backoff, usernames are tracked
+  // here so several sessions sharing one throttle slow down a guesser
+  // spreading attempts over them. Waiting is up to the caller: the service
+  // loop simply leaves input unread until the deadline.
+  //
+  // An attempt for a username still waiting is held, not rejected: the
+  // service checks it once the name's deadline has passed. Refusing such
+  // attempts would let any client lock the real user out by failing on
+  // purpose, checking them at once would let a guesser with many sessions
+  // ignore the name's wait. Held attempts are checked once, however far
+  // other sessions have pushed the deadline meanwhile, so the real user is
+  // delayed at most one wait; the price is that a guesser gets one guess
+  // per session and wait.
+  class LoginThrottle
+  {
+  public:
+    static constexpr uint32_t FREE_FAILURES = 3;
+    static constexpr uint64_t DEFAULT_BASE_DELAY_MS = 1000;
+    static constexpr uint64_t DEFAULT_MAX_DELAY_MS = 60000;
+    static constexpr uint64_t FORGET_AFTER_US = 15ull * 60 * 1000000;  // Failures this old no longer count
+    static constexpr size_t MAX_TRACKED_USERNAMES = 64;
+
+    struct Backoff
+    {
+      uint32_t failures = 0;
+      uint64_t lastFailure_us = 0;
+      uint64_t deadline_us = 0;  // No attempt is handled before
+
+      bool isWaiting(uint64_t now_us) const { return now_us < deadline_us; }
+    };
+
+    explicit LoginThrottle(uint64_t baseDelay_ms = DEFAULT_BASE_DELAY_MS, uint64_t maxDelay_ms = DEFAULT_MAX_DELAY_MS);
+
+    // Count a failure, returns the delay until the next attempt. A name that
+    // finds every slot taken by a waiting one is not tracked and costs 0.
+    uint64_t recordFailure(Backoff& backoff, uint64_t now_us) const;
+    uint64_t recordFailure(const std::string& username, uint64_t now_us);
+
+    void recordSuccess(const std::string& username) { _usernames.erase(username); }
+
+    // Whether attempts for 'username' are still held back, and until when (0 if untracked)
+    bool isWaiting(const std::string& username, uint64_t now_us) const;
+    uint64_t getDeadline_us(const std::string& username) const;
+
+    // Wait imposed after 'failures' consecutive failures
+    uint64_t getDelay_us(uint32_t failures) const;
+
+    size_t getTrackedUsernames() const { return _usernames.size(); }
+
+  private:
+    const uint64_t _baseDelay_us;
+    const uint64_t _maxDelay_us;
+
+    // Bounded, names are chosen by the client. When full, the entry failing
+    // longest ago among those no longer waiting makes room.
+    std::unordered_map<std::string, Backoff> _usernames;
+  };
+
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include "cliService/cli/RequestBase.hpp"
+
+namespace cliService
+{
+
+  // Key pressed while the pager waits below a page of output
+  class PagerRequest : public RequestBase
+  {
+  public:
+    enum class Action
+    {
+      NextPage,  // Space
+      NextLine,  // Enter
+      Quit       // 'q'
+    };
+
+    explicit PagerRequest(Action action)
+      : _action(action)
+    {}
+
+    Action getAction() const { return _action; }
+
+  private:
+    Action _action;
+  };
+
+}
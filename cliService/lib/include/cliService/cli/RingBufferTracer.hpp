@@ -0,0 +1,44 @@
+#pragma once
+#include "cliService/cli/TracerIf.hpp"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace cliService
+{
+
+  // Keeps the most recent 'capacity' phases in a preallocated ring, so
+  // recording never allocates, and dumps them as Chrome trace-event JSON
+  // (load in chrome://tracing or Perfetto).
+  class RingBufferTracer : public TracerIf
+  {
+  public:
+    struct Event
+    {
+      TracePhase phase;
+      uint64_t begin_us;
+      uint64_t end_us;
+      std::string_view detail;
+    };
+
+    explicit RingBufferTracer(size_t capacity);
+
+    void record(TracePhase phase, uint64_t begin_us, uint64_t end_us, std::string_view detail) override;
+
+    // Oldest first
+    std::vector<Event> getEvents() const;
+    std::string toChromeTraceJson() const;
+
+    size_t size() const { return _count; }
+    size_t capacity() const { return _events.size(); }
+    size_t getDroppedCount() const { return _dropped; }
+    void clear();
+
+  private:
+    std::vector<Event> _events;
+    size_t _next = 0;   // Slot written by the next record()
+    size_t _count = 0;
+    size_t _dropped = 0;
+  };
+
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace cliService
+{
+
+  struct ScriptOptions
+  {
+    bool stopOnError = false;  // Skip the remaining lines after the first failing one
+    bool showPrompts = true;   // Write prompt and command line before every response
+  };
+
+  struct ScriptResult
+  {
+    size_t executed = 0;       // Command lines run, blank and comment ('#') lines excluded
+    size_t failed = 0;         // Of those, the ones not answering with Status::Success
+    size_t stoppedAtLine = 0;  // Line the script was cut short at, 0 if it ran to the end
+  };
+
+  // Provides scripts for the 'source' command by name
+  class ScriptLoaderIf
+  {
+  public:
+    virtual ~ScriptLoaderIf() = default;
+
+    // Fill 'content' with the script called 'name', false if there is none
+    virtual bool load(std::string_view name, std::string& content) = 0;
+  };
+
+}
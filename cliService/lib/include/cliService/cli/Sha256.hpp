@@ -0,0 +1,50 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace cliService
+{
+
+  // SHA-256 (FIPS 180-4), self-contained so password hashing needs no
+  // crypto library on the target
+  class Sha256
+  {
+  public:
+    static constexpr size_t DIGEST_SIZE = 32;
+    static constexpr size_t BLOCK_SIZE = 64;
+
+    using Digest = std::array<uint8_t, DIGEST_SIZE>;
+
+    Sha256() { reset(); }
+
+    void reset();
+    void update(const uint8_t* data, size_t length);
+    void update(std::string_view data) { update(reinterpret_cast<const uint8_t*>(data.data()), data.length()); }
+    Digest finish();
+
+    static Digest hash(std::string_view data);
+
+  private:
+    void compress(const uint8_t* block);
+
+    std::array<uint32_t, 8> _state;
+    std::array<uint8_t, BLOCK_SIZE> _block;
+    size_t _blockLength;
+    uint64_t _totalLength;
+  };
+
+  // HMAC-SHA-256 (RFC 2104)
+  Sha256::Digest hmacSha256(std::string_view key, std::string_view message);
+
+  // PBKDF2 with HMAC-SHA-256 (RFC 8018), fills 'length' bytes of 'out'. The
+  // keyed inner and outer hash states are computed once and reused for
+  // every iteration.
+  void pbkdf2Sha256(std::string_view password, std::string_view salt, uint32_t iterations, uint8_t* out, size_t length);
+
+  // Compares without an early exit, so the time taken does not tell how
+  // many leading bytes matched
+  bool constantTimeEquals(const uint8_t* a, const uint8_t* b, size_t length);
+
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include "cliService/cli/ClockIf.hpp"
+#include <cstdint>
+#include <string_view>
+
+namespace cliService
+{
+
+  // Phases of a request, in the order CLIService runs through them
+  enum class TracePhase : uint8_t
+  {
+    Parse,      // InputParser turning the line buffer into a request
+    Resolve,    // Path resolution
+    Authorize,  // Access level check
+    Execute,    // CommandIf::execute
+    Render,     // Writing the response
+    Count
+  };
+
+  inline const char* getTracePhaseName(TracePhase phase)
+  {
+    switch (phase)
+    {
+      case TracePhase::Parse:     return "parse";
+      case TracePhase::Resolve:   return "resolve";
+      case TracePhase::Authorize: return "authorize";
+      case TracePhase::Execute:   return "execute";
+      case TracePhase::Render:    return "render";
+      case TracePhase::Count:
+      default:                    return "?";
+    }
+  }
+
+  // Receives one call per completed phase. 'detail' names the node involved
+  // where there is one and only stays valid while the tree is unchanged.
+  // Tracing is off (and costs a null check) unless a tracer is configured.
+  class TracerIf
+  {
+  public:
+    virtual ~TracerIf() = default;
+
+    virtual void record(TracePhase phase, uint64_t begin_us, uint64_t end_us, std::string_view detail) = 0;
+  };
+
+  // Records the enclosing scope as one phase, if there is a tracer. The
+  // clock is only used (and may only be null) when there is no tracer.
+  class TraceScope
+  {
+  public:
+    TraceScope(TracerIf* tracer, const ClockIf* clock, TracePhase phase, std::string_view detail = {})
+      : _tracer(tracer)
+      , _clock(clock)
+      , _phase(phase)
+      , _detail(detail)
+      , _begin_us(tracer ? clock->now_us() : 0)
+    {}
+
+    ~TraceScope()
+    {
+      if (_tracer) {
+        _tracer->record(_phase, _begin_us, _clock->now_us(), _detail);
+      }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+    void setDetail(std::string_view detail) { _detail = detail; }
+
+  private:
+    TracerIf* _tracer;
+    const ClockIf* _clock;
+    TracePhase _phase;
+    std::string_view _detail;
+    uint64_t _begin_us;
+  };
+
+}
@@ -0,0 +1,122 @@
+#pragma once
+#include "cliService/cli/CharIOStreamIf.hpp"
+#include "cliService/cli/ClockIf.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <vector>
+
+namespace cliService
+{
+
+  enum class TxPriority
+  {
+    Interactive,  // Echo, line editing and the initial prompt
+    Bulk          // Command output
+  };
+
+  // Paces writes to a stream at a fixed byte rate, so a slow link (e.g. a
+  // 115200 baud UART) is never handed more than it can drain. Interactive
+  // bytes go out before queued bulk bytes, unless a fence holds them back
+  // behind bulk bytes ending the current line. Both queues are
+  // preallocated rings; a rate of 0 writes everything straight through.
+  class TxScheduler
+  {
+  public:
+    static constexpr size_t UNLIMITED_SPACE = std::numeric_limits<size_t>::max();
+    static constexpr uint64_t MAX_BURST_US = 10000;  // Credit never accumulates beyond 10 ms worth of bytes
+    static constexpr size_t INTERACTIVE_CAPACITY = 256;
+
+    TxScheduler(CharIOStreamIf& ioStream, const ClockIf& clock, uint32_t bytesPerSecond, size_t bulkCapacity);
+
+    // Interactive bytes are never dropped, if their queue is full it is
+    // written out at once. Bulk bytes not fitting the queue push the oldest
+    // queued bytes out early, callers check getFreeSpace() to avoid that.
+    void write(std::string_view text, TxPriority priority);
+
+    // Send as many queued bytes as the time since the last call allows
+    void pump();
+
+    // Interactive bytes written from now on wait for the bulk bytes queued
+    // so far, e.g. keystrokes typed after a prompt or completion that is
+    // still queued. Bytes already in the interactive queue are not held.
+    void fence();
+
+    bool isPaced() const { return _bytesPerSecond > 0; }
+    bool isIdle() const { return _interactive.count == 0 && _bulk.count == 0; }
+
+    size_t getQueueDepth(TxPriority priority) const { return queue(priority).count; }
+    size_t getPeakQueueDepth(TxPriority priority) const { return queue(priority).peak; }
+    size_t getFreeSpace(TxPriority priority) const;
+    uint32_t getBytesPerSecond() const { return _bytesPerSecond; }
+    uint64_t getSentCount() const { return _sent; }
+
+  private:
+    struct Queue
+    {
+      std::vector<char> data;
+      size_t head = 0;   // Oldest byte
+      size_t count = 0;
+      size_t peak = 0;
+      uint64_t pushed = 0;  // Totals since construction
+      uint64_t popped = 0;
+    };
+
+    const Queue& queue(TxPriority priority) const { return priority == TxPriority::Interactive ? _interactive : _bulk; }
+    void push(Queue& queue, std::string_view text);
+    size_t send(Queue& queue, size_t maxBytes);
+    size_t sendInteractive(size_t maxBytes);
+    bool isFenced() const { return _bulk.popped < _fenceAt; }
+
+    CharIOStreamIf& _ioStream;
+    const ClockIf& _clock;
+    const uint32_t _bytesPerSecond;
+
+    Queue _interactive;
+    Queue _bulk;
+
+    uint64_t _fenceAt = 0;        // Bulk position the held interactive bytes wait for
+    size_t _unfencedBytes = 0;    // Interactive bytes queued before the fence
+
+    uint64_t _lastPump_us;
+    uint64_t _credit = 0;  // In bytes times 1e6, keeps fractions between pumps
+    uint64_t _sent = 0;
+  };
+
+  // Stream view writing through a TxScheduler at one priority, everything
+  // else goes to the underlying stream
+  class TxChannel : public CharIOStreamIf
+  {
+  public:
+    TxChannel(CharIOStreamIf& ioStream, TxScheduler& scheduler, TxPriority priority)
+      : _ioStream(ioStream), _scheduler(scheduler), _priority(priority) {}
+
+    bool putChar(char c) override
+    {
+      _scheduler.write(std::string_view(&c, 1), _priority);
+      return true;
+    }
+
+    bool putString(std::string_view str) override
+    {
+      _scheduler.write(str, _priority);
+      return true;
+    }
+
+    bool getChar(char& c) override { return _ioStream.getChar(c); }
+    bool getCharTimeout(char& c, uint32_t timeout_ms) override { return _ioStream.getCharTimeout(c, timeout_ms); }
+    bool available() const override { return _ioStream.available(); }
+    void flush() override { _ioStream.flush(); }
+    bool isOpen() const override { return _ioStream.isOpen(); }
+    bool hasError() const override { return _ioStream.hasError(); }
+    const char* getLastError() const override { return _ioStream.getLastError(); }
+    void clearError() override { _ioStream.clearError(); }
+
+  private:
+    CharIOStreamIf& _ioStream;
+    TxScheduler& _scheduler;
+    const TxPriority _priority;
+  };
+
+}
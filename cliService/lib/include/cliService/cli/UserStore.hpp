@@ -0,0 +1,69 @@
+#pragma once
+#include "cliService/cli/Sha256.hpp"
+#include "cliService/cli/User.hpp"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cliService
+{
+
+  // Accounts indexed by username, holding a salted PBKDF2-HMAC-SHA-256 hash
+  // instead of the password. The iteration count is the work factor: every
+  // verification costs 2 * iterations SHA-256 compressions, so raising it
+  // slows down guessing and logins alike. Salts are derived from the seed
+  // and a counter, so stores that must not share salts (one per device) need
+  // distinct seeds.
+  class UserStore
+  {
+  public:
+    static constexpr uint32_t DEFAULT_ITERATIONS = 1000;
+    static constexpr size_t SALT_SIZE = 16;
+    static constexpr size_t HASH_SIZE = Sha256::DIGEST_SIZE;
+
+    using Salt = std::array<uint8_t, SALT_SIZE>;
+    using Hash = std::array<uint8_t, HASH_SIZE>;
+
+    explicit UserStore(uint32_t iterations = DEFAULT_ITERATIONS, uint64_t seed = 0);
+
+    // Hash the password of 'user' with a fresh salt, false if the name is taken
+    bool addUser(const User& user);
+
+    // Add an account provisioned with a hash made elsewhere (see hashPassword())
+    bool addHashedUser(const std::string& username, AccessLevel level, const Salt& salt, const Hash& hash, uint32_t iterations);
+
+    // The account if the password matches, nullptr otherwise. Every attempt
+    // costs getVerificationIterations(), whether the name exists or which
+    // work factor its account was hashed with, so timing does not reveal
+    // which names exist. The returned User holds no password.
+    const User* authenticate(const std::string& username, const std::string& password) const;
+
+    bool contains(const std::string& username) const { return _users.count(username) > 0; }
+    size_t size() const { return _users.size(); }
+    bool empty() const { return _users.empty(); }
+    uint32_t getIterations() const { return _iterations; }
+    uint32_t getVerificationIterations() const { return _dummy.iterations; }
+
+    static Hash hashPassword(const std::string& password, const Salt& salt, uint32_t iterations);
+
+  private:
+    struct Account
+    {
+      User user;
+      Salt salt;
+      Hash hash;
+      uint32_t iterations;
+    };
+
+    Salt generateSalt();
+    void setDummy(uint32_t iterations);
+
+    const uint32_t _iterations;
+    std::unordered_map<std::string, Account> _users;
+    std::array<uint64_t, 2> _saltState;  // Seed and counter, salts only need to be unique, not secret
+    Account _dummy;                      // Verified against for unknown names, at the highest stored work factor
+  };
+
+}
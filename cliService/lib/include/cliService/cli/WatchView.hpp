@@ -0,0 +1,39 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace cliService
+{
+
+  // Lines shown by 'watch', redrawn differentially: a changed line gets a
+  // cursor move to its first differing column followed by the differing
+  // span only, lines that got shorter or disappeared are erased to the end
+  // of the line. Unchanged lines cost nothing.
+  class WatchView
+  {
+  public:
+    // 'firstRow' is the 1-based screen row of the first line
+    explicit WatchView(size_t firstRow)
+      : _firstRow(firstRow)
+    {}
+
+    // Append the ANSI sequences turning the shown lines into 'lines' to 'out'
+    void update(const std::vector<std::string>& lines, std::string& out);
+
+    // Append a cursor move to the start of the row after the last line
+    void moveBelow(std::string& out) const;
+
+    size_t getLineCount() const { return _lines.size(); }
+
+    // Append "ESC[<row>;<column>H", both 1-based
+    static void moveCursor(size_t row, size_t column, std::string& out);
+
+  private:
+    void updateLine(size_t index, const std::string& line, std::string& out);
+
+    const size_t _firstRow;
+    std::vector<std::string> _lines;  // As currently on screen
+  };
+
+}
@@ -1,4 +1,6 @@
 #pragma once
+#include "cliService/tree/OutputSourceIf.hpp"
+#include <memory>
 #include <string>
 #include <string_view>
 
@@ -44,6 +46,7 @@ namespace cliService
     static CLIResponse error(std::string_view msg) { return CLIResponse(msg, Status::Error); }
 
     const std::string& getMessage() const { return _message; }
+    void setMessage(std::string msg) { _message = std::move(msg); }
     void appendToMessage(const std::string& msg) { _message += msg; }
     void appendToMessage(std::string_view msg) { _message += msg; }
 
@@ -61,6 +64,10 @@ namespace cliService
     void setPrefixNewLine(bool prefix) { _prefixNewLine = prefix; }
     void setPostfixNewLine(bool postfix) { _postfixNewLine = postfix; }
 
+    // Lines pulled from the source are written after the message, one per line
+    const std::shared_ptr<OutputSourceIf>& getOutputSource() const { return _outputSource; }
+    void setOutputSource(std::shared_ptr<OutputSourceIf> source) { _outputSource = std::move(source); }
+
   private:
     std::string _message;
     Status _status;
@@ -69,6 +76,7 @@ namespace cliService
     bool _inlineMessage;
     bool _prefixNewLine;
     bool _postfixNewLine;
+    std::shared_ptr<OutputSourceIf> _outputSource;
   };
 
 }
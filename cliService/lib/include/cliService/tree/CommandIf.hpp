@@ -1,6 +1,7 @@
 #pragma once
 #include "cliService/tree/NodeIf.hpp"
 #include "cliService/tree/CLIResponse.hpp"
+#include "cliService/tree/CommandMetrics.hpp"
 #include <vector>
 
 namespace cliService
@@ -21,6 +22,10 @@ namespace cliService
     bool isDirectory() const override { return false; }
     const std::string& getDescription() const { return _description; }
 
+    // Recorded by CLIService around every execute() call. Bookkeeping only,
+    // so it stays writable through const references to the tree.
+    CommandMetrics& getMetrics() const { return _metrics; }
+
     static CLIResponse createInvalidArgumentCountResponse(size_t expected)
     {
       std::string response;
@@ -39,6 +44,7 @@ namespace cliService
 
   private:
     std::string _description;
+    mutable CommandMetrics _metrics;
   };
 
 }
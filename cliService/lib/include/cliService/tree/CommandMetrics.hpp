@@ -0,0 +1,93 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace cliService
+{
+
+  // Invocation statistics of a single command. Fixed size, so recording
+  // never allocates. Latencies go into log2 buckets: bucket 0 holds 0-1 us,
+  // bucket i holds [2^i, 2^(i+1)) us and the last bucket everything above.
+  class CommandMetrics
+  {
+  public:
+    static constexpr size_t BUCKET_COUNT = 24;  // Last regular bucket starts at ~4 s
+
+    void record(uint64_t latency_us, bool isError)
+    {
+      _invocations++;
+      if (isError) { _errors++; }
+
+      _totalLatency_us += latency_us;
+      if (latency_us > _maxLatency_us) { _maxLatency_us = latency_us; }
+
+      _histogram[getBucketIndex(latency_us)]++;
+    }
+
+    void reset() { *this = CommandMetrics(); }
+
+    uint32_t getInvocations() const { return _invocations; }
+    uint32_t getErrors() const { return _errors; }
+    uint64_t getTotalLatency_us() const { return _totalLatency_us; }
+    uint64_t getMaxLatency_us() const { return _maxLatency_us; }
+    uint32_t getBucketCount(size_t bucket) const { return _histogram[bucket]; }
+
+    uint64_t getAverageLatency_us() const
+    {
+      return _invocations == 0 ? 0 : _totalLatency_us / _invocations;
+    }
+
+    // Upper bound of the bucket holding the given percentile (0-100), capped
+    // at the maximum seen latency
+    uint64_t getPercentileLatency_us(uint32_t percentile) const
+    {
+      if (_invocations == 0) { return 0; }
+
+      const uint64_t rank = (static_cast<uint64_t>(_invocations) * percentile + 99) / 100;
+      uint64_t seen = 0;
+
+      for (size_t bucket = 0; bucket < BUCKET_COUNT; ++bucket)
+      {
+        seen += _histogram[bucket];
+
+        if (seen >= rank && seen > 0)
+        {
+          const uint64_t upperBound = (uint64_t(2) << bucket) - 1;
+          return upperBound < _maxLatency_us ? upperBound : _maxLatency_us;
+        }
+      }
+
+      return _maxLatency_us;
+    }
+
+    static constexpr size_t getBucketIndex(uint64_t latency_us)
+    {
+      size_t bucket = 0;
+
+      while (latency_us > 1 && bucket < BUCKET_COUNT - 1)
+      {
+        latency_us >>= 1;
+        bucket++;
+      }
+
+      return bucket;
+    }
+
+  private:
+    uint32_t _invocations = 0;
+    uint32_t _errors = 0;
+    uint64_t _totalLatency_us = 0;
+    uint64_t _maxLatency_us = 0;
+    std::array<uint32_t, BUCKET_COUNT> _histogram{};
+  };
+
+  // Copy of a command's metrics, taken by CLIService::getMetricsSnapshot()
+  struct CommandMetricsSnapshot
+  {
+    std::string path;
+    CommandMetrics metrics;
+  };
+
+}
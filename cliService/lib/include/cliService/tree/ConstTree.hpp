@@ -0,0 +1,188 @@
+#pragma once
+#include "cliService/tree/CLIResponse.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cliService
+{
+
+  enum class AccessLevel;
+
+  using ConstNodeIndex = uint16_t;
+  using ConstCommandFn = CLIResponse (*)(const std::vector<std::string>& args);
+
+  // One entry of a compile-time menu tree. Children of a directory occupy the
+  // contiguous index range [firstChild, firstChild + childCount).
+  struct ConstNode
+  {
+    std::string_view name;
+    AccessLevel accessLevel;
+    ConstNodeIndex parent;
+    ConstNodeIndex firstChild;
+    ConstNodeIndex childCount;
+    ConstCommandFn command;        // nullptr for directories
+    std::string_view description;
+
+    constexpr bool isDirectory() const { return command == nullptr; }
+  };
+
+  // Read-only view of a constexpr node table. Index 0 is the root directory.
+  // All lookups work directly on the table; nothing is copied or allocated.
+  class ConstTree
+  {
+  public:
+    static constexpr ConstNodeIndex ROOT = 0;
+    static constexpr ConstNodeIndex INVALID = 0xFFFF;
+
+    static constexpr ConstNode directory(std::string_view name, AccessLevel level, ConstNodeIndex parent,
+                                         ConstNodeIndex firstChild, ConstNodeIndex childCount)
+    {
+      return ConstNode{name, level, parent, firstChild, childCount, nullptr, ""};
+    }
+
+    static constexpr ConstNode command(std::string_view name, AccessLevel level, ConstNodeIndex parent,
+                                       ConstCommandFn fn, std::string_view description = "")
+    {
+      return ConstNode{name, level, parent, 0, 0, fn, description};
+    }
+
+    template<size_t N>
+    constexpr ConstTree(const ConstNode (&nodes)[N])
+      : _nodes(nodes)
+      , _size(N)
+    {
+      static_assert(N > 0 && N < INVALID, "Tree must contain a root and fit the index type");
+    }
+
+    constexpr size_t size() const { return _size; }
+    constexpr const ConstNode& node(ConstNodeIndex index) const { return _nodes[index]; }
+
+    // Verifies parent/child links so a malformed table can be rejected with static_assert
+    constexpr bool isValid() const
+    {
+      if (_nodes[ROOT].parent != INVALID || !_nodes[ROOT].isDirectory()) { return false; }
+
+      for (size_t i = 0; i < _size; ++i)
+      {
+        const ConstNode& n = _nodes[i];
+
+        if (i != ROOT && n.parent >= _size) { return false; }
+
+        if (!n.isDirectory())
+        {
+          if (n.childCount != 0) { return false; }
+          continue;
+        }
+
+        if (n.childCount > 0 && (n.firstChild <= i || n.firstChild + n.childCount > _size)) {
+          return false;
+        }
+
+        for (size_t c = n.firstChild; c < size_t(n.firstChild) + n.childCount; ++c)
+        {
+          if (_nodes[c].parent != i) { return false; }
+
+          // Name collisions are rejected like in Directory
+          for (size_t o = c + 1; o < size_t(n.firstChild) + n.childCount; ++o) {
+            if (_nodes[o].name == _nodes[c].name) { return false; }
+          }
+        }
+      }
+
+      return true;
+    }
+
+    constexpr ConstNodeIndex findChild(ConstNodeIndex dir, std::string_view name) const
+    {
+      if (dir >= _size) { return INVALID; }
+
+      const ConstNode& d = _nodes[dir];
+
+      for (ConstNodeIndex c = d.firstChild; c < d.firstChild + d.childCount; ++c) {
+        if (_nodes[c].name == name) { return c; }
+      }
+
+      return INVALID;
+    }
+
+    // Resolves a '/'-separated path relative to 'current' (or the root when the
+    // path is absolute). Paths are walked element by element, ".." above the
+    // root stays at the root. Returns INVALID if the path cannot be resolved.
+    constexpr ConstNodeIndex resolve(std::string_view path, ConstNodeIndex current = ROOT) const
+    {
+      ConstNodeIndex node = (!path.empty() && path[0] == '/') ? ROOT : current;
+      if (node >= _size) { return INVALID; }
+
+      size_t pos = 0;
+
+      while (pos < path.length())
+      {
+        size_t end = path.find('/', pos);
+        if (end == std::string_view::npos) { end = path.length(); }
+
+        std::string_view element = path.substr(pos, end - pos);
+        pos = end + 1;
+
+        if (element.empty() || element == ".") { continue; }
+
+        if (element == "..")
+        {
+          if (node != ROOT) { node = _nodes[node].parent; }
+          if (node >= _size) { return INVALID; }
+          continue;
+        }
+
+        if (!_nodes[node].isDirectory()) { return INVALID; }
+
+        node = findChild(node, element);
+        if (node == INVALID) { return INVALID; }
+      }
+
+      return node;
+    }
+
+    // A node is accessible if neither it nor any of its ancestors require a
+    // higher level. INVALID and out of range indices are not accessible.
+    constexpr bool isAccessible(ConstNodeIndex index, AccessLevel level) const
+    {
+      if (index >= _size) { return false; }
+
+      for (ConstNodeIndex i = index; i < _size; i = _nodes[i].parent) {
+        if (_nodes[i].accessLevel > level) { return false; }
+      }
+
+      return true;
+    }
+
+    std::string getAbsolutePath(ConstNodeIndex index) const
+    {
+      if (index == ROOT) { return "/"; }
+      if (index >= _size) { return ""; }
+
+      std::string path;
+
+      for (ConstNodeIndex i = index; i != ROOT && i < _size; i = _nodes[i].parent) {
+        path.insert(0, "/" + std::string(_nodes[i].name));
+      }
+
+      return path;
+    }
+
+    CLIResponse execute(ConstNodeIndex index, const std::vector<std::string>& args) const
+    {
+      if (index >= _size || _nodes[index].isDirectory()) {
+        return CLIResponse(std::string("Not a command"), CLIResponse::Status::InvalidPath);
+      }
+
+      return _nodes[index].command(args);
+    }
+
+  private:
+    const ConstNode* _nodes;
+    size_t _size;
+  };
+
+}
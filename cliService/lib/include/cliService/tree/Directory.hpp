@@ -2,6 +2,8 @@
 #include "cliService/tree/NodeIf.hpp"
 #include "cliService/tree/CommandIf.hpp"
 #include "cliService/tree/Path.hpp"
+#include "cliService/tree/FrozenTree.hpp"
+#include "cliService/tree/TreeViewCache.hpp"
 #include <memory>
 #include <vector>
 #include <functional>
@@ -12,10 +14,19 @@
 namespace cliService
 {
 
+  // Returned by visitors passed to Directory::visit
+  enum class TraversalAction
+  {
+    Continue,      // Descend into the node's children
+    SkipChildren,  // Don't visit anything below this node
+    Stop           // End the traversal
+  };
+
   class Directory : public NodeIf
   {
   public:
     explicit Directory(std::string name, AccessLevel level);
+    ~Directory() override;
 
     bool isDirectory() const override { return true; }
 
@@ -24,29 +35,66 @@ namespace cliService
     Path getRelativePath(const NodeIf& node) const;
     void traverse(const std::function<void(const NodeIf&, size_t)>& visitor, size_t depth = 0) const;
 
+    // Pre-order traversal of this directory and its subtree using an explicit
+    // stack. The visitor is called as visitor(const NodeIf&, size_t depth) and
+    // may return a TraversalAction to prune subtrees or stop early.
+    // Returns false if the visitor stopped the traversal.
+    template<typename Visitor>
+    bool visit(Visitor&& visitor, size_t depth = 0) const;
+
+    // Children in insertion order
+    size_t getChildCount() const { return _children.size(); }
+    NodeIf* getChild(size_t index) const { return getNodePtr(_children[index]); }
+
+    // Compact this directory's subtree into a FrozenTree used by the read-only
+    // hot paths. Any later mutation of the tree discards the snapshot again.
+    void freeze();
+    bool isFrozen() const { return _frozenTree != nullptr; }
+    const FrozenTree* getFrozenTree() const { return _frozenTree.get(); }
+
+    // Snapshot of the nearest frozen ancestor (or this directory), nullptr if none
+    const FrozenTree* findFrozenTree() const;
+
+    // Topmost ancestor, or this directory if it has no parent
+    const Directory& getRoot() const;
+
+    // Node with the given ID, in O(1). Only the root holds the ID table.
+    NodeIf* findNodeById(uint32_t id) const;
+
+    // Per access level views of this directory's subtree. Shared state is kept
+    // on the root, so use getRoot().getViewCache() to share between sessions.
+    TreeViewCache& getViewCache() const;
+
     // Add references to statically allocated nodes
     void addStaticDirectory(Directory& dir)
     {
       checkNameCollision(dir.getName());
+      invalidateCaches();
       dir.setParent(this);
+      dir.updateSubtreeAccessLevels();
       _children.emplace_back(&dir);
+      registerSubtree(dir);
     }
 
     void addStaticCommand(CommandIf& cmd)
     {
       checkNameCollision(cmd.getName());
+      invalidateCaches();
       cmd.setParent(this);
       _children.emplace_back(&cmd);
+      registerSubtree(cmd);
     }
 
     // Create and add dynamically allocated nodes
     Directory& addDynamicDirectory(const std::string& name, AccessLevel level)
     {
       checkNameCollision(name);
+      invalidateCaches();
       auto dir = std::make_unique<Directory>(name, level);
       Directory* dirPtr = dir.get();
       dirPtr->setParent(this);
       _children.emplace_back(std::move(dir));
+      registerSubtree(*dirPtr);
       return *dirPtr;
     }
 
@@ -56,15 +104,19 @@ namespace cliService
       static_assert(std::is_base_of_v<CommandIf, T>, "T must derive from CommandIf");
 
       checkNameCollision(name);
+      invalidateCaches();
       auto cmd = std::make_unique<T>(std::move(name), level, std::move(description));
       T* cmdPtr = cmd.get();
       cmdPtr->setParent(this);
       _children.emplace_back(std::move(cmd));
+      registerSubtree(*cmdPtr);
 
       return *cmdPtr;
     }
 
   private:
+    friend class FrozenTree;
+
     using ChildPtr = std::variant<NodeIf*, std::unique_ptr<NodeIf>>;
     std::vector<ChildPtr> _children;
 
@@ -78,6 +130,79 @@ namespace cliService
     }
 
     void checkNameCollision(const std::string& name) const;
+    void invalidateCaches();
+    void updateSubtreeAccessLevels();
+    void registerSubtree(NodeIf& node);
+
+    std::unique_ptr<FrozenTree> _frozenTree;
+    mutable std::unique_ptr<TreeViewCache> _viewCache;
+    std::vector<NodeIf*> _nodesById;  // Indexed by ID - 1, the root itself is ROOT_ID
+
+    template<typename Visitor>
+    static TraversalAction applyVisitor(Visitor& visitor, const NodeIf& node, size_t depth)
+    {
+      if constexpr (std::is_void_v<std::invoke_result_t<Visitor&, const NodeIf&, size_t>>)
+      {
+        visitor(node, depth);
+        return TraversalAction::Continue;
+      }
+      else {
+        return visitor(node, depth);
+      }
+    }
   };
 
+
+  template<typename Visitor>
+  bool Directory::visit(Visitor&& visitor, size_t depth) const
+  {
+    if (const FrozenTree* frozen = findFrozenTree())
+    {
+      std::vector<std::pair<FrozenTree::Index, size_t>> stack;
+      stack.emplace_back(frozen->indexOf(*this), depth);
+
+      while (!stack.empty())
+      {
+        auto [index, nodeDepth] = stack.back();
+        stack.pop_back();
+
+        TraversalAction action = applyVisitor(visitor, *frozen->getNode(index), nodeDepth);
+
+        if (action == TraversalAction::Stop) { return false; }
+        if (action == TraversalAction::SkipChildren) { continue; }
+
+        // Push in reverse so children are visited in insertion order
+        const FrozenTree::Index first = frozen->getFirstChild(index);
+
+        for (FrozenTree::Index i = frozen->getChildCount(index); i > 0; --i) {
+          stack.emplace_back(first + i - 1, nodeDepth + 1);
+        }
+      }
+
+      return true;
+    }
+
+    std::vector<std::pair<const NodeIf*, size_t>> stack;
+    stack.emplace_back(this, depth);
+
+    while (!stack.empty())
+    {
+      auto [node, nodeDepth] = stack.back();
+      stack.pop_back();
+
+      TraversalAction action = applyVisitor(visitor, *node, nodeDepth);
+
+      if (action == TraversalAction::Stop) { return false; }
+      if (action == TraversalAction::SkipChildren || !node->isDirectory()) { continue; }
+
+      const auto& children = static_cast<const Directory*>(node)->_children;
+
+      for (auto it = children.rbegin(); it != children.rend(); ++it) {
+        stack.emplace_back(getNodePtr(*it), nodeDepth + 1);
+      }
+    }
+
+    return true;
+  }
+
 }
\ No newline at end of file
@@ -0,0 +1,74 @@
+#pragma once
+#include "cliService/tree/NodeIf.hpp"
+#include "cliService/tree/Path.hpp"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace cliService
+{
+
+  class Directory;
+
+  // Read-only snapshot of a built tree, compacted into contiguous arrays
+  // (structure-of-arrays). Nodes are numbered breadth first, so the children
+  // of every directory occupy a contiguous index range. Index 0 is the root.
+  //
+  // Created by Directory::freeze() and discarded as soon as the tree is mutated.
+  class FrozenTree
+  {
+  public:
+    using Index = uint32_t;
+
+    static constexpr Index ROOT = 0;
+    static constexpr Index INVALID = UINT32_MAX;
+
+    enum class Kind : uint8_t
+    {
+      Directory,
+      Command
+    };
+
+    explicit FrozenTree(const Directory& root);
+
+    size_t size() const { return _nodes.size(); }
+
+    std::string_view getName(Index index) const
+    {
+      return std::string_view(_names.data() + _nameOffsets[index], _nameOffsets[index + 1] - _nameOffsets[index]);
+    }
+
+    Index getParent(Index index) const { return _parents[index]; }
+    Index getFirstChild(Index index) const { return _firstChildren[index]; }
+    Index getChildCount(Index index) const { return _childCounts[index]; }
+    AccessLevel getEffectiveAccessLevel(Index index) const { return _effectiveAccessLevels[index]; }
+    bool isDirectory(Index index) const { return _kinds[index] == Kind::Directory; }
+    NodeIf* getNode(Index index) const { return _nodes[index]; }
+
+    // Returns INVALID if the node is not part of this snapshot
+    Index indexOf(const NodeIf& node) const;
+
+    // Returns INVALID if 'dir' has no child called 'name'
+    Index findChild(Index dir, std::string_view name) const;
+
+    // Resolves 'path' relative to 'current' (ignored for absolute paths) with the
+    // same semantics as PathResolver, without building intermediate paths.
+    Index resolve(const Path& path, Index current) const;
+
+  private:
+    void appendNode(NodeIf& node, Index parent);
+
+    std::string _names;                 // All names back to back
+    std::vector<uint32_t> _nameOffsets; // size() + 1 entries, name i spans [off[i], off[i + 1])
+    std::vector<Index> _parents;
+    std::vector<Index> _firstChildren;
+    std::vector<Index> _childCounts;
+    std::vector<AccessLevel> _effectiveAccessLevels;
+    std::vector<Kind> _kinds;
+    std::vector<NodeIf*> _nodes;        // Back references used for execution
+    std::unordered_map<const NodeIf*, Index> _indexByNode;
+  };
+
+}
@@ -1,4 +1,6 @@
 #pragma once
+#include <cstdint>
+#include <limits>
 #include <string>
 
 namespace cliService
@@ -9,10 +11,14 @@ namespace cliService
   class NodeIf
   {
   public:
+    static constexpr uint32_t ROOT_ID = 0;
+    static constexpr uint32_t INVALID_ID = std::numeric_limits<uint32_t>::max();
+
     explicit NodeIf(std::string name, AccessLevel level)
       : _name(std::move(name))
       , _parent(nullptr)
       , _accessLevel(level)
+      , _effectiveAccessLevel(level)
     {}
 
     virtual ~NodeIf() = default;
@@ -22,13 +28,33 @@ namespace cliService
     const std::string& getName() const { return _name; };
     AccessLevel getAccessLevel() const { return _accessLevel; }
 
+    // Highest access level required along the path from the root to this node
+    AccessLevel getEffectiveAccessLevel() const { return _effectiveAccessLevel; }
+
     NodeIf* getParent() const { return _parent; }
-    void setParent(NodeIf* parent) { _parent = parent; }
+
+    // Dense ID within the tree of the root, assigned when the node is added
+    // and never reused. A subtree added to another tree is renumbered there.
+    uint32_t getId() const { return _id; }
+
+    void setParent(NodeIf* parent)
+    {
+      _parent = parent;
+      _effectiveAccessLevel = _accessLevel;
+
+      if (_parent && _parent->_effectiveAccessLevel > _effectiveAccessLevel) {
+        _effectiveAccessLevel = _parent->_effectiveAccessLevel;
+      }
+    }
 
   protected:
+    friend class Directory;
+
     std::string _name;
     NodeIf* _parent;
     AccessLevel _accessLevel;
+    AccessLevel _effectiveAccessLevel;
+    uint32_t _id = INVALID_ID;
   };
 
 }
@@ -0,0 +1,72 @@
+#pragma once
+#include "cliService/tree/OutputSourceIf.hpp"
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cliService
+{
+
+  // One stage of a 'command | filter | ...' pipeline. Filters wrap the
+  // output source of a response and pull from it line by line, so filtered
+  // lines are never buffered and 'head' stops pulling once it has enough.
+  //
+  //   grep [-v] <text>  Lines containing (-v: not containing) the text
+  //   head [N]          First N lines, 10 by default
+  //   tail [N]          Last N lines, 10 by default
+  //   count             Number of lines
+  class OutputFilter
+  {
+  public:
+    static constexpr size_t DEFAULT_LINE_COUNT = 10;
+    static constexpr size_t MAX_TAIL_LINES = 1000;  // Tail keeps this many lines in memory at most
+
+    enum class Kind
+    {
+      Grep,
+      Head,
+      Tail,
+      Count
+    };
+
+    // Parse the words of one stage, nullopt if it is not a valid filter
+    static std::optional<OutputFilter> parse(const std::vector<std::string>& words);
+
+    Kind getKind() const { return _kind; }
+    const std::string& getPattern() const { return _pattern; }
+    size_t getLineCount() const { return _lineCount; }
+
+    // Source yielding the lines of 'upstream' passing this filter
+    std::shared_ptr<OutputSourceIf> apply(std::shared_ptr<OutputSourceIf> upstream) const;
+
+  private:
+    explicit OutputFilter(Kind kind)
+      : _kind(kind)
+    {}
+
+    Kind _kind;
+    std::string _pattern;
+    bool _invert = false;
+    size_t _lineCount = DEFAULT_LINE_COUNT;
+  };
+
+  // Yields the lines of 'message' split at 'newLine', then those of 'rest'.
+  // Lets filters see a response body as one stream of lines.
+  class MessageLineSource : public OutputSourceIf
+  {
+  public:
+    MessageLineSource(std::string message, std::string_view newLine, std::shared_ptr<OutputSourceIf> rest);
+
+    bool nextLine(std::string& line) override;
+
+  private:
+    std::string _message;
+    std::string _newLine;
+    size_t _offset = 0;
+    std::shared_ptr<OutputSourceIf> _rest;
+  };
+
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <functional>
+#include <string>
+
+namespace cliService
+{
+
+  // Lazily produced response body, pulled one line at a time while the
+  // response is written, so long outputs never exist in memory as a whole
+  class OutputSourceIf
+  {
+  public:
+    virtual ~OutputSourceIf() = default;
+
+    // Replaces 'line' with the next line (without line ending). Returns false
+    // once the source is exhausted.
+    virtual bool nextLine(std::string& line) = 0;
+  };
+
+  // Adapts a generator function, e.g. for commands producing long dumps:
+  // response.setOutputSource(std::make_shared<CallbackOutputSource>(
+  //   [i = 0](std::string& line) mutable { line = std::to_string(i); return ++i <= 1000; }));
+  class CallbackOutputSource : public OutputSourceIf
+  {
+  public:
+    using Callback = std::function<bool(std::string& line)>;
+
+    explicit CallbackOutputSource(Callback callback)
+      : _callback(std::move(callback))
+    {}
+
+    bool nextLine(std::string& line) override { return _callback(line); }
+
+  private:
+    Callback _callback;
+  };
+
+}
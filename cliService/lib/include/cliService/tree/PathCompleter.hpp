@@ -1,6 +1,7 @@
 #pragma once
 #include "cliService/tree/Path.hpp"
 #include "cliService/tree/PathResolver.hpp"
+#include "cliService/tree/FrozenTree.hpp"
 #include <string>
 #include <string_view>
 #include <vector>
@@ -24,8 +25,14 @@ namespace cliService
 
     static CompletionResult complete(const Directory& currentDir, std::string_view partialInput, AccessLevel accessLevel)
     {
-      if (partialInput.empty()) {
-        return listCurrentDirectory(currentDir, accessLevel);
+      const Directory& root = currentDir.getRoot();
+      TreeViewCache& views = root.getViewCache();
+
+      if (partialInput.empty())
+      {
+        CompletionResult result;
+        result.allOptions = views.getCompletions(currentDir, accessLevel, "");
+        return result;
       }
 
       Path partialPath(partialInput);
@@ -43,110 +50,133 @@ namespace cliService
         elements.pop_back();
       }
 
-      // Find the directory to complete in
-      const Directory* targetDir = &currentDir;
+      // Only a snapshot of the whole tree can resolve ".." above the current directory
+      const FrozenTree* frozen = root.getFrozenTree();
+      FrozenTree::Index currentIndex = frozen ? frozen->indexOf(currentDir) : FrozenTree::INVALID;
+      const Directory* targetDir = nullptr;
 
-      if (!elements.empty() || partialPath.isAbsolute())
+      if (currentIndex != FrozenTree::INVALID)
       {
-        // First verify each path component exists before normalization
-        const Directory* currentTarget = targetDir;
-        bool isValid = true;
+        FrozenTree::Index targetIndex = findTargetDirectory(*frozen, currentIndex, elements, endsWithSlash, accessLevel);
 
-        for (const auto& element : elements)
-        {
-          if (element == "..")
-          {
-            if (currentTarget->getParent()) {
-              currentTarget = static_cast<const Directory*>(currentTarget->getParent());
-            }
+        if (targetIndex != FrozenTree::INVALID) {
+          targetDir = static_cast<const Directory*>(frozen->getNode(targetIndex));
+        }
+      }
+      else {
+        targetDir = findTargetDirectory(currentDir, elements, endsWithSlash, accessLevel);
+      }
 
-            continue;
-          }
+      if (!targetDir) { return CompletionResult{}; }
 
-          if (element == ".") {
-            continue;
-          }
+      // Get completions in the target directory
+      return buildResult(views.getCompletions(*targetDir, accessLevel, toComplete), toComplete, elements, partialPath.isAbsolute());
+    }
 
-          auto* nextNode = currentTarget->findNode({element});
+  private:
+    // Verify each path component exists before normalization
+    static const Directory* findTargetDirectory(
+      const Directory& currentDir,
+      const std::vector<std::string>& elements,
+      bool endsWithSlash,
+      AccessLevel accessLevel)
+    {
+      const Directory* currentTarget = &currentDir;
 
-          if (!nextNode)
-          {
-            isValid = false;
-            break;
+      for (const auto& element : elements)
+      {
+        if (element == "..")
+        {
+          if (currentTarget->getParent()) {
+            currentTarget = static_cast<const Directory*>(currentTarget->getParent());
           }
 
-          // If this is not the last element, or if we end with a slash,
-          // the node must be a directory
-          if (!nextNode->isDirectory() && 
-              (&element != &elements.back() || endsWithSlash)) {
-            isValid = false;
-            break;
-          }
+          continue;
+        }
 
-          if (nextNode->getAccessLevel() > accessLevel) {
-            isValid = false;
-            break;
-          }
+        if (element == ".") {
+          continue;
+        }
 
-          if (nextNode->isDirectory()) {
-            currentTarget = static_cast<const Directory*>(nextNode);
-          }
+        auto* nextNode = currentTarget->findNode({element});
+
+        if (!nextNode) {
+          return nullptr;
         }
 
-        if (!isValid) {
-          return CompletionResult{};
+        // If this is not the last element, or if we end with a slash,
+        // the node must be a directory
+        if (!nextNode->isDirectory() && 
+            (&element != &elements.back() || endsWithSlash)) {
+          return nullptr;
         }
 
-        targetDir = currentTarget;
+        if (nextNode->getEffectiveAccessLevel() > accessLevel) {
+          return nullptr;
+        }
+
+        if (nextNode->isDirectory()) {
+          currentTarget = static_cast<const Directory*>(nextNode);
+        }
       }
 
-      // Get completions in the target directory
-      return completeInDirectory(*targetDir, toComplete, elements, accessLevel, partialPath.isAbsolute());
+      return currentTarget;
     }
 
-  private:
-    static CompletionResult listCurrentDirectory(const Directory& dir, AccessLevel accessLevel)
+    static FrozenTree::Index findTargetDirectory(
+      const FrozenTree& tree,
+      FrozenTree::Index currentIndex,
+      const std::vector<std::string>& elements,
+      bool endsWithSlash,
+      AccessLevel accessLevel)
     {
-      CompletionResult result;
+      FrozenTree::Index currentTarget = currentIndex;
 
-      dir.traverse(
-        [&result, accessLevel](const NodeIf& node, size_t depth)
+      for (const auto& element : elements)
+      {
+        if (element == "..")
         {
-          if (depth == 1 && node.getAccessLevel() <= accessLevel) {
-            result.allOptions.push_back(node.getName() + (node.isDirectory() ? "/" : ""));
+          if (tree.getParent(currentTarget) != FrozenTree::INVALID) {
+            currentTarget = tree.getParent(currentTarget);
           }
-        },
-        0
-      );
 
-      std::sort(result.allOptions.begin(), result.allOptions.end());
-      return result;
+          continue;
+        }
+
+        if (element == ".") {
+          continue;
+        }
+
+        FrozenTree::Index next = tree.findChild(currentTarget, element);
+
+        if (next == FrozenTree::INVALID) {
+          return FrozenTree::INVALID;
+        }
+
+        if (!tree.isDirectory(next) && (&element != &elements.back() || endsWithSlash)) {
+          return FrozenTree::INVALID;
+        }
+
+        if (tree.getEffectiveAccessLevel(next) > accessLevel) {
+          return FrozenTree::INVALID;
+        }
+
+        if (tree.isDirectory(next)) {
+          currentTarget = next;
+        }
+      }
+
+      return currentTarget;
     }
 
-    static CompletionResult completeInDirectory(
-      const Directory& dir, 
+    static CompletionResult buildResult(
+      std::vector<std::string> options,
       const std::string& partial,
       const std::vector<std::string>& pathElements,
-      AccessLevel accessLevel,
       bool isAbsolute)
     {
       CompletionResult result;
-
-      // First pass: collect all matching entries
-      dir.traverse(
-        [&](const NodeIf& node, size_t depth) {
-          if (depth == 1 && node.getAccessLevel() <= accessLevel)
-          {
-            const std::string& name = node.getName();
-            if (name.length() >= partial.length() && name.compare(0, partial.length(), partial) == 0)
-            {
-              // Store full name with directory indicator
-              result.allOptions.push_back(name + (node.isDirectory() ? "/" : ""));
-            }
-          }
-        },
-        0
-      );
+      result.allOptions = std::move(options);
 
       // Then process the collected options
       if (!result.allOptions.empty())
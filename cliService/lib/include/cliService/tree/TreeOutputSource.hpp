@@ -0,0 +1,53 @@
+#pragma once
+#include "cliService/tree/OutputSourceIf.hpp"
+#include "cliService/tree/NodeIf.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cliService
+{
+
+  class Directory;
+
+  // Renders the subtree of a directory as indented lines, one node per line,
+  // walking the tree on demand. Memory is bounded by the tree depth. Nodes
+  // above 'level' are hidden along with everything below them.
+  class TreeOutputSource : public OutputSourceIf
+  {
+  public:
+    static constexpr size_t INDENT_WIDTH = 2;
+    static constexpr size_t UNLIMITED_DEPTH = SIZE_MAX;
+
+    TreeOutputSource(const Directory& start, AccessLevel level, bool showCmdDescription = false,
+                     size_t maxDepth = UNLIMITED_DEPTH);
+
+    bool nextLine(std::string& line) override;
+
+    // Append " #<id>" with the node ID of every node
+    void setShowIds(bool show) { _showIds = show; }
+
+    // Appends the tree line of 'node' at 'depth' to 'line'
+    static void formatNode(const NodeIf& node, size_t depth, bool showCmdDescription, std::string& line);
+
+  private:
+    struct Frame
+    {
+      const Directory* dir;
+      size_t nextChild;
+      size_t depth;  // Depth of the directory's children
+    };
+
+    const NodeIf* nextNode(size_t& depth);
+
+    const Directory& _start;
+    const AccessLevel _level;
+    const bool _showCmdDescription;
+    const size_t _maxDepth;
+
+    bool _showIds = false;
+    bool _startEmitted = false;
+    std::vector<Frame> _stack;
+  };
+
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include "cliService/tree/NodeIf.hpp"
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace cliService
+{
+
+  class Directory;
+
+  // Per access level projections of a tree, built lazily on first use and
+  // owned by the root directory, so every session of the same access level
+  // shares them. The root clears the cache whenever the tree is mutated.
+  class TreeViewCache
+  {
+  public:
+    struct DirectoryView
+    {
+      std::vector<const NodeIf*> visibleChildren;  // Insertion order
+      std::vector<std::string> completionIndex;    // Sorted names, directories with trailing "/"
+      std::vector<std::pair<std::string, std::string>> listingTexts;  // Rendered '?' output by line ending
+    };
+
+    const DirectoryView& getView(const Directory& dir, AccessLevel level) { return getMutableView(dir, level); }
+
+    // Completion options of 'dir' starting with 'prefix', in sorted order
+    std::vector<std::string> getCompletions(const Directory& dir, AccessLevel level, std::string_view prefix);
+
+    // Return the cached '?' text, calling render() to produce it on first use.
+    // Sessions may end lines differently, so texts are kept per 'newLine'.
+    template<typename Render>
+    const std::string& getListingText(const Directory& dir, AccessLevel level, std::string_view newLine, Render&& render)
+    {
+      auto& texts = getMutableView(dir, level).listingTexts;
+
+      for (const auto& [key, text] : texts) {
+        if (key == newLine) { return text; }
+      }
+
+      texts.emplace_back(std::string(newLine), render());
+      return texts.back().second;
+    }
+
+    void clear() { _levels.clear(); }
+
+    // Number of directory views built since construction (for diagnostics)
+    size_t getBuildCount() const { return _buildCount; }
+
+  private:
+    DirectoryView& getMutableView(const Directory& dir, AccessLevel level);
+    DirectoryView buildView(const Directory& dir, AccessLevel level);
+
+    std::vector<std::unordered_map<const Directory*, DirectoryView>> _levels;  // Indexed by access level
+    size_t _buildCount = 0;
+  };
+
+}
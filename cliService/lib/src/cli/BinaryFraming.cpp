@@ -0,0 +1,164 @@
+#include "cliService/cli/BinaryFraming.hpp"
+
+namespace cliService
+{
+
+  BinaryFrameDecoder::BinaryFrameDecoder()
+  {
+    _frame.reserve(MAX_FRAME_LENGTH);
+  }
+
+
+  BinaryFrameDecoder::Result BinaryFrameDecoder::push(char c)
+  {
+    const auto byte = static_cast<uint8_t>(c);
+
+    if (!_haveLength)
+    {
+      _frameLength |= static_cast<uint32_t>(byte & 0x7F) << (7 * _lengthBytes++);
+
+      if (byte & 0x80)
+      {
+        if (_lengthBytes < MAX_VARINT_LENGTH) { return Result::Incomplete; }
+
+        reset();
+        return Result::Malformed;
+      }
+
+      _haveLength = true;
+
+      // Most likely a corrupted length, skipping that many bytes could
+      // swallow the rest of the session. The next byte starts a new frame.
+      if (_frameLength > MAX_FRAME_LENGTH)
+      {
+        reset();
+        return Result::Malformed;
+      }
+
+      // Empty frames are padding, used by clients to get back in sync
+      if (_frameLength == 0)
+      {
+        reset();
+        return Result::Incomplete;
+      }
+
+      return Result::Incomplete;
+    }
+    else {
+      _frame += c;
+    }
+
+    if (_frame.length() < _frameLength) { return Result::Incomplete; }
+
+    const bool valid = decodeFrame();
+    reset();
+
+    return valid ? Result::Complete : Result::Malformed;
+  }
+
+
+  size_t BinaryFrameDecoder::encodeVarint(uint32_t value, char* out)
+  {
+    size_t length = 0;
+
+    do
+    {
+      uint8_t byte = value & 0x7F;
+      value >>= 7;
+
+      if (value != 0) {
+        byte |= 0x80;
+      }
+
+      out[length++] = static_cast<char>(byte);
+    } while (value != 0);
+
+    return length;
+  }
+
+
+  void BinaryFrameDecoder::appendVarint(uint32_t value, std::string& out)
+  {
+    char bytes[MAX_VARINT_LENGTH];
+    out.append(bytes, encodeVarint(value, bytes));
+  }
+
+
+  bool BinaryFrameDecoder::readVarint(std::string_view& in, uint32_t& value)
+  {
+    value = 0;
+
+    for (size_t i = 0; i < MAX_VARINT_LENGTH && i < in.length(); ++i)
+    {
+      const auto byte = static_cast<uint8_t>(in[i]);
+      value |= static_cast<uint32_t>(byte & 0x7F) << (7 * i);
+
+      if (!(byte & 0x80))
+      {
+        in.remove_prefix(i + 1);
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+
+  bool BinaryFrameDecoder::decodeFrame()
+  {
+    std::string_view in = _frame;
+    uint32_t argc = 0;
+
+    if (!readVarint(in, _nodeId) || !readVarint(in, argc)) { return false; }
+
+    // Every argument takes at least its length byte
+    if (argc > in.length()) { return false; }
+
+    // Keep the strings of earlier requests for their capacity
+    if (_args.size() < argc) {
+      _args.resize(argc);
+    }
+
+    for (uint32_t i = 0; i < argc; ++i)
+    {
+      uint32_t length = 0;
+
+      if (!readVarint(in, length) || length > in.length()) { return false; }
+
+      _args[i].assign(in.substr(0, length));
+      in.remove_prefix(length);
+    }
+
+    _args.resize(argc);
+
+    // Trailing bytes mean client and server disagree on the format
+    return in.empty();
+  }
+
+
+  void BinaryFrameDecoder::reset()
+  {
+    _frame.clear();
+    _frameLength = 0;
+    _lengthBytes = 0;
+    _haveLength = false;
+  }
+
+
+  void encodeBinaryRequest(uint32_t nodeId, const std::vector<std::string>& args, std::string& out)
+  {
+    std::string payload;
+    BinaryFrameDecoder::appendVarint(nodeId, payload);
+    BinaryFrameDecoder::appendVarint(static_cast<uint32_t>(args.size()), payload);
+
+    for (const auto& arg : args)
+    {
+      BinaryFrameDecoder::appendVarint(static_cast<uint32_t>(arg.length()), payload);
+      payload += arg;
+    }
+
+    BinaryFrameDecoder::appendVarint(static_cast<uint32_t>(payload.length()), out);
+    out += payload;
+  }
+
+}
@@ -1,13 +1,18 @@
 #include "cliService/cli/CLIService.hpp"
 #include "cliService/cli/CommandRequest.hpp"
 #include "cliService/cli/LoginRequest.hpp"
+#include "cliService/cli/PagerRequest.hpp"
 #include "cliService/cli/TabCompletionRequest.hpp"
 #include "cliService/cli/CharIOStreamIf.hpp"
 #include "cliService/cli/User.hpp"
 #include "cliService/tree/CommandIf.hpp"
 #include "cliService/tree/Directory.hpp"
+#include "cliService/tree/OutputFilter.hpp"
 #include "cliService/tree/PathCompleter.hpp"
+#include "cliService/tree/TreeOutputSource.hpp"
+#include <algorithm>
 #include <cassert>
+#include <cctype>
 
 
 namespace cliService
@@ -19,25 +24,60 @@ namespace cliService
     {"tree"   , &CLIService::handleGlobalTree},
     {"help"   , &CLIService::handleGlobalHelp},
     {"?"      , &CLIService::handleGlobalQuestionMark},
-    {"clear"  , &CLIService::handleGlobalClear}
+    {"clear"  , &CLIService::handleGlobalClear},
+    {"stats"  , &CLIService::handleGlobalStats},
+    {"mode"   , &CLIService::handleGlobalMode},
+    {"source" , &CLIService::handleGlobalSource},
+    {"watch"  , &CLIService::handleGlobalWatch},
+    {"jobs"   , &CLIService::handleGlobalJobs},
+    {"fg"     , &CLIService::handleGlobalFg}
   };
 
 
   CLIService::CLIService(CLIServiceConfiguration config)
     : _ioStream(config._ioStream)
-    , _inputParser(_ioStream, _currentCLIState, config._inputTimeout_ms)
+    , _clock(config._clock ? *config._clock : _defaultClock)
+    , _txScheduler(_ioStream, _clock, config._txBytesPerSecond, config._txQueueCapacity)
+    , _interactiveStream(_ioStream, _txScheduler, TxPriority::Interactive)
+    , _inputParser(_interactiveStream, _currentCLIState, config._inputTimeout_ms)
+    , _machineMode(config._machineMode)
+    , _frameTimeout_us(static_cast<uint64_t>(config._inputTimeout_ms) * 1000)
+    , _pageHeight(config._pageHeight)
+    , _maxRequestsPerService(config._maxRequestsPerService)
     , _commandHistory(config._historySize)
-    , _users(std::move(config._users))
+    , _defaultUserStore(config._passwordIterations, config._saltSeed ^ _clock.now_us())
+    , _userStore(config._userStore ? *config._userStore : _defaultUserStore)
     , _currentUser(std::nullopt)
+    , _defaultLoginThrottle(config._loginBackoff_ms, config._maxLoginBackoff_ms)
+    , _loginThrottle(config._loginThrottle ? *config._loginThrottle : _defaultLoginThrottle)
     , _rootDirectory(std::move(config._rootDirectory))
     , _currentDirectory(getRootPtr())
     , _pathResolver(*getRootPtr())
     , _currentCLIState(CLIState::Inactive)
     , _messages(std::move(config._messages))
+    , _tracer(config._tracer)
+    , _scriptLoader(config._scriptLoader)
+    , _scriptAccessLevel(config._scriptAccessLevel)
+    , _jobs(config._jobOutputCapacity)
   {
-    assert(!_users.empty() && "User list cannot be empty");
+    _outputBuffer.reserve(OUTPUT_BUFFER_CAPACITY);
+
+    // Only the hashes are kept
+    for (const auto& user : config._users) {
+      _defaultUserStore.addUser(user);
+    }
+
+    assert(!_userStore.empty() && "User list cannot be empty");
     assert(getRootPtr() != nullptr && "Root directory cannot be null");
     assert(_currentDirectory != nullptr && "Current directory must be set");
+    assert(_maxRequestsPerService > 0 && "At least one request must be handled per service() call");
+
+    _inputParser.setTracer(_tracer, _clock);
+    _inputParser.setMachineMode(_machineMode);
+
+#if CLISERVICE_LATENCY_STATS
+    _inputParser.setLatencyProbe(_clock, _latencyStats);
+#endif
   }
 
 
@@ -46,10 +86,16 @@ namespace cliService
     assert(_currentCLIState == CLIState::Inactive && "Service must be inactive to activate");
 
     _currentCLIState = CLIState::LoggedOut;
-    _ioStream.putString(_messages.getNewLine());
-    _ioStream.putString(std::string(_messages.getIndentation()) + std::string(_messages.getWelcomeMessage()));
-    _ioStream.putString(_messages.getNewLine(2));
-    _ioStream.putString(getPromptString());
+    clearSessionState();
+
+    // Clients expect nothing but frames
+    if (_machineMode) { return; }
+
+    _interactiveStream.putString(_messages.getNewLine());
+    _interactiveStream.putString(std::string(_messages.getIndentation()) + std::string(_messages.getWelcomeMessage()));
+    _interactiveStream.putString(_messages.getNewLine(2));
+    _interactiveStream.putString(getPromptString());
+    _txScheduler.pump();
   }
 
 
@@ -57,16 +103,150 @@ namespace cliService
   {
     if (_currentCLIState == CLIState::Inactive) { return; }
 
-    // Get next request from parser
-    auto requestPtr = _inputParser.getNextRequest();
-    if (!requestPtr || !*requestPtr) { return; }
+    // Output held back by pacing continues as the queue drains
+    if (isDrainingOutput()) {
+      continueOutput();
+    }
+
+    // Background jobs advance a little on every call
+    _jobs.service(JOB_LINES_PER_SERVICE);
+
+    // A running watch owns the session until a key is pressed
+    if (_watch)
+    {
+      serviceWatch();
+      _txScheduler.pump();
+      return;
+    }
+
+    // Lines already buffered in the stream are handled back to back, each
+    // with its own response, instead of one per call
+    for (size_t handled = 0; handled < _maxRequestsPerService; ++handled)
+    {
+      // A session backing off after failed logins costs one clock read
+      if (isLoginThrottled()) { break; }
+
+      if (!serviceNextRequest() || _currentCLIState == CLIState::Inactive) { break; }
+    }
+
+    // Queued echo goes out ahead of queued output
+    _txScheduler.pump();
+  }
+
+
+  bool CLIService::serviceNextRequest()
+  {
+    if (_binaryMode) {
+      return serviceNextFrame();
+    }
+
+    std::unique_ptr<RequestBase> request = std::move(_deferredRequest);
+
+    if (!request)
+    {
+      // Keys are still read and echoed while output drains
+      if (isDrainingOutput() && _ioStream.available()) {
+        _pagedOutput->typedAhead = true;
+      }
+
+      // Get next request from parser
+      auto requestPtr = _inputParser.getNextRequest();
+      if (!requestPtr || !*requestPtr) { return false; }
+
+      request = std::move(*requestPtr);
+    }
+
+    if (isDrainingOutput())
+    {
+      // Handled once the previous output is out
+      _deferredRequest = std::move(request);
+      return false;
+    }
+
+    if (holdLogin(request)) { return false; }
 
     // Get response from appropriate handler
-    CLIResponse response = handleRequest(**requestPtr);
+    CLIResponse response = handleRequest(*request);
 
     // Handle output
     handleOutput(response);
+
+#if CLISERVICE_LATENCY_STATS
+    recordLatency(*request);
+#endif
+
+    // Further input belongs to the pager or a watch, or waits for the output to drain
+    return !_pagedOutput && !_watch;
+  }
+
+
+  bool CLIService::serviceNextFrame()
+  {
+    if (!_ioStream.available()) { return false; }
+
+    // Silence in the middle of a frame means the client gave up on it, this
+    // is how it gets back in sync
+    const uint64_t now_us = _clock.now_us();
+
+    if (_binaryDecoder.isPending() && now_us - _lastFrameRead_us >= _frameTimeout_us) {
+      _binaryDecoder.reset();
+    }
+
+    _lastFrameRead_us = now_us;
+    char c;
+
+    while (_ioStream.available() && _ioStream.getChar(c))
+    {
+      switch (_binaryDecoder.push(c))
+      {
+        case BinaryFrameDecoder::Result::Incomplete:
+          break;
+
+        case BinaryFrameDecoder::Result::Malformed:
+          handleOutput(CLIResponse(std::string_view("Malformed frame"), CLIResponse::Status::InvalidArguments));
+          return true;
+
+        case BinaryFrameDecoder::Result::Complete:
+        default:
+        {
+          const uint32_t nodeId = _binaryDecoder.getNodeId();
+          handleOutput(handleBinaryRequest(nodeId, _binaryDecoder.getArgs()));
+
+          // Answered in binary, everything after is text again
+          if (nodeId == LEAVE_BINARY_MODE_ID) {
+            _binaryMode = false;
+          }
+
+          return true;
+        }
+      }
+    }
+
+    return false;
+  }
+
+
+#if CLISERVICE_LATENCY_STATS
+  void CLIService::recordLatency(const RequestBase& request)
+  {
+    LatencyStats::Kind kind;
+
+    if (dynamic_cast<const CommandRequest*>(&request)) {
+      kind = LatencyStats::Kind::Command;
+    }
+    else if (dynamic_cast<const TabCompletionRequest*>(&request)) {
+      kind = LatencyStats::Kind::Tab;
+    }
+    else if (dynamic_cast<const HistoryNavigationRequest*>(&request)) {
+      kind = LatencyStats::Kind::History;
+    }
+    else {
+      return;  // Logins are dominated by the user, not the library
+    }
+
+    _latencyStats.record(kind, _clock.now_us() - _inputParser.getRequestReceivedAt_us());
   }
+#endif
 
 
   CLIResponse CLIService::handleRequest(const RequestBase& request)
@@ -91,34 +271,58 @@ namespace cliService
       return handleRequest(*historyRequest);
     }
 
+    if (const auto* pagerRequest = dynamic_cast<const PagerRequest*>(&request)) {
+      return handleRequest(*pagerRequest);
+    }
+
     return CLIResponse(static_cast<std::string>("Unknown request type"), CLIResponse::Status::Error);
   }
 
 
-  NodeIf* CLIService::resolvePath(const Path& path) const {
+  NodeIf* CLIService::resolvePath(const Path& path) const
+  {
+    TraceScope trace(_tracer, &_clock, TracePhase::Resolve);
+
+    // '@<id>' names a node directly, no path resolution needed
+    if (const auto id = parseNodeId(path)) {
+      return getRootPtr()->findNodeById(*id);
+    }
+
     return _pathResolver.resolve(path, *_currentDirectory);
   }
 
 
-  bool CLIService::validatePathAccess(const NodeIf* node) const
+  std::optional<uint32_t> CLIService::parseNodeId(const Path& path)
   {
-    assert(_currentUser && "No user logged in");
+    if (path.isAbsolute() || path.elements().size() != 1) { return std::nullopt; }
 
-    if (!node) { return false; }
+    const std::string& element = path.elements().front();
+    if (element.length() < 2 || element.length() > 11 || element.front() != '@') { return std::nullopt; }
 
-    // Check access levels up the tree
-    const NodeIf* current = node;
+    uint64_t id = 0;
 
-    while (current)
+    for (size_t i = 1; i < element.length(); ++i)
     {
-      if (current->getAccessLevel() > _currentUser->getAccessLevel()) {
-        return false;
-      }
-
-      current = current->getParent();
+      if (element[i] < '0' || element[i] > '9') { return std::nullopt; }
+      id = id * 10 + static_cast<uint64_t>(element[i] - '0');
     }
 
-    return true;
+    if (id >= NodeIf::INVALID_ID) { return std::nullopt; }
+
+    return static_cast<uint32_t>(id);
+  }
+
+
+  bool CLIService::validatePathAccess(const NodeIf* node) const
+  {
+    assert(_currentUser && "No user logged in");
+
+    if (!node) { return false; }
+
+    TraceScope trace(_tracer, &_clock, TracePhase::Authorize, node->getName());
+
+    // Effective level already accounts for every ancestor
+    return node->getEffectiveAccessLevel() <= _currentUser->getAccessLevel();
   }
 
 
@@ -127,18 +331,37 @@ namespace cliService
   }
 
 
-  std::string CLIService::getPromptString() const
+  // Nothing a user left behind carries over to the next one
+  void CLIService::clearSessionState()
   {
-    std::string prompt = "";
+    _jobs.clear();
+    _watch.reset();
+    _pagedOutput.reset();
+    _inputParser.setPagerMode(false);
+  }
+
+
+  const std::string& CLIService::getPromptString() const
+  {
+    const bool loggedIn = _currentCLIState == CLIState::LoggedIn && _currentUser;
+    const uint32_t directoryId = loggedIn ? _currentDirectory->getId() : NodeIf::INVALID_ID;
 
-    if (_currentCLIState == CLIState::LoggedIn && _currentUser)
+    // Only rebuilt when the directory or the user changed
+    if (_promptValid && _promptDirectoryId == directoryId) { return _prompt; }
+
+    _prompt.clear();
+
+    if (loggedIn)
     {
-      prompt += _currentUser->getUsername() + "@";
-      prompt += _pathResolver.getAbsolutePath(*_currentDirectory).toString();
+      _prompt += _currentUser->getUsername() + "@";
+      _prompt += _pathResolver.getAbsolutePath(*_currentDirectory).toString();
     }
 
-    prompt += "> ";
-    return prompt;
+    _prompt += "> ";
+    _promptDirectoryId = directoryId;
+    _promptValid = true;
+
+    return _prompt;
   }
 
 
@@ -161,24 +384,46 @@ namespace cliService
 
 
   std::string CLIService::getNodeListDisplay(NodeDisplayMode mode, bool showCmdDescription) const
+  {
+    auto render = [&]() { return renderNodeListDisplay(mode, showCmdDescription); };
+
+    // Directory listings are shared by all sessions of the same access level and
+    // line ending until the tree changes. Flat lists use no indentation.
+    TreeViewCache& views = getRootPtr()->getViewCache();
+    const AccessLevel level = _currentUser->getAccessLevel();
+
+    if (mode == NodeDisplayMode::FlatList && showCmdDescription) {
+      return views.getListingText(*_currentDirectory, level, _messages.getNewLine(), render);
+    }
+
+    return render();
+  }
+
+
+  std::string CLIService::renderNodeListDisplay(NodeDisplayMode mode, bool showCmdDescription) const
   {
     std::string nodeList = "";
 
-    _currentDirectory->traverse([&](const NodeIf& node, size_t depth) {
-      if (mode == NodeDisplayMode::FlatList && depth != 1) {
-        return; // Skip nodes not at depth 1 for flat list
+    _currentDirectory->visit([&](const NodeIf& node, size_t depth) {
+      // Nothing below an inaccessible node is shown
+      if (node.getEffectiveAccessLevel() > _currentUser->getAccessLevel()) {
+        return TraversalAction::SkipChildren;
       }
 
-      if (node.getAccessLevel() <= _currentUser->getAccessLevel()) {
-        std::string indent = "";
+      if (mode == NodeDisplayMode::FlatList && depth != 1) {
+        return TraversalAction::Continue; // Only nodes at depth 1 for flat list
+      }
 
-        if (mode == NodeDisplayMode::Tree && depth > 0) {
-          indent = std::string(depth * 2, ' ');
-        }
+      std::string indent = "";
 
-        nodeList += formatNodeInfo(node, indent, showCmdDescription);
-        nodeList += _messages.getNewLine();
+      if (mode == NodeDisplayMode::Tree && depth > 0) {
+        indent = std::string(depth * 2, ' ');
       }
+
+      nodeList += formatNodeInfo(node, indent, showCmdDescription);
+      nodeList += _messages.getNewLine();
+
+      return mode == NodeDisplayMode::FlatList ? TraversalAction::SkipChildren : TraversalAction::Continue;
     });
 
     return nodeList;
@@ -198,49 +443,127 @@ namespace cliService
   CLIResponse CLIService::handleRequest(const InvalidLoginRequest& request)
   {
     (void)request;
-    return CLIResponse::error(_messages.getInvalidLoginMessage());
+    return rejectLogin(nullptr);
   }
 
 
   CLIResponse CLIService::handleRequest(const LoginRequest& request)
   {
-    const auto& username = request.getUsername();
-    const auto& password = request.getPassword();
+    const std::string& username = request.getUsername();
 
-    auto userIt = std::find_if(_users.begin(), _users.end(),
-      [&](const User& user) {
-        return user.getUsername() == username && user.getPassword() == password;
-      });
+    const User* user = _userStore.authenticate(username, request.getPassword());
+    if (!user) {
+      return rejectLogin(&username);
+    }
 
-    CLIResponse response = CLIResponse::success();
+    _currentUser = *user;
+    _currentCLIState = CLIState::LoggedIn;
+    _promptValid = false;
+    _loginBackoff = LoginThrottle::Backoff();
+    _loginThrottle.recordSuccess(username);
 
-    if (userIt != _users.end())
-    {
-      _currentUser = *userIt;
-      _currentCLIState = CLIState::LoggedIn;
-      response.appendToMessage(_messages.getLoggedInMessage());
+    return CLIResponse::success(_messages.getLoggedInMessage());
+  }
+
+
+  CLIResponse CLIService::rejectLogin(const std::string* username)
+  {
+    const uint64_t now_us = _clock.now_us();
+    uint64_t delay_us = _loginThrottle.recordFailure(_loginBackoff, now_us);
+
+    if (username) {
+      delay_us = std::max(delay_us, _loginThrottle.recordFailure(*username, now_us));
     }
-    else {
-      response.appendToMessage(_messages.getInvalidLoginMessage());
-      response.setStatus(CLIResponse::Status::Error);
+
+    // The session waits for the longer of both
+    _loginBackoff.deadline_us = now_us + delay_us;
+
+    CLIResponse response = CLIResponse::error(_messages.getInvalidLoginMessage());
+
+    if (delay_us > 0)
+    {
+      const uint64_t seconds = (delay_us + 999999) / 1000000;
+      response.appendToMessage(_messages.getNewLine());
+      response.appendToMessage("Too many failed logins, next attempt in " + std::to_string(seconds) + " s");
     }
 
     return response;
   }
 
 
+  bool CLIService::isLoginThrottled() const
+  {
+    return _currentCLIState == CLIState::LoggedOut && _loginBackoff.isWaiting(_clock.now_us());
+  }
+
+
+  // A login for a name still waiting after failures elsewhere is neither
+  // rejected unheard nor checked at once, the session waits with it until
+  // the name's deadline
+  bool CLIService::holdLogin(std::unique_ptr<RequestBase>& request)
+  {
+    const auto* login = dynamic_cast<const LoginRequest*>(request.get());
+    if (!login) { return false; }
+
+    // Held once already, checked now however far the deadline moved since
+    if (_loginHeld)
+    {
+      _loginHeld = false;
+      return false;
+    }
+
+    const uint64_t deadline_us = _loginThrottle.getDeadline_us(login->getUsername());
+    if (deadline_us <= _clock.now_us()) { return false; }
+
+    _loginBackoff.deadline_us = std::max(_loginBackoff.deadline_us, deadline_us);
+    _deferredRequest = std::move(request);
+    _loginHeld = true;
+    return true;
+  }
+
+
   CLIResponse CLIService::handleRequest(const CommandRequest& request) 
   {
     assert(_currentUser && "No user logged in");
 
     const auto& path = request.getPath();
-    
+
+    // Filters are checked before the command runs, a typo must not cost its side effects
+    std::vector<OutputFilter> filters;
+
+    for (const auto& stage : request.getFilters())
+    {
+      auto filter = OutputFilter::parse(stage);
+
+      if (!filter || path.isEmpty()) {
+        return CLIResponse(std::string_view("Usage: <command> | grep [-v] <text> | head [N] | tail [N] | count"),
+                           CLIResponse::Status::InvalidArguments);
+      }
+
+      filters.push_back(std::move(*filter));
+    }
+
+    if (request.isBackground()) {
+      return startJob(request, filters);
+    }
+
     if (!path.isEmpty())
     {
       const auto& command = path.elements().front();
 
-      if (GLOBAL_COMMAND_HANDLERS.find(command) != GLOBAL_COMMAND_HANDLERS.end()) {
-        return handleGlobalCommand(command, request.getArgs());
+      if (GLOBAL_COMMAND_HANDLERS.find(command) != GLOBAL_COMMAND_HANDLERS.end())
+      {
+        CLIResponse response = handleGlobalCommand(command, request.getArgs());
+
+        // 'watch cmd | filter' filters every refresh of the watched command
+        if (_watch && command == "watch") {
+          _watch->filters = std::move(filters);
+        }
+        else {
+          applyOutputFilters(response, filters);
+        }
+
+        return response;
       }
     }
 
@@ -264,17 +587,25 @@ namespace cliService
     // Handle directory navigation or command execution
     if (node->isDirectory())
     {
+      if (!filters.empty())
+      {
+        response.appendToMessage(std::string("Only command output can be filtered"));
+        response.setStatus(CLIResponse::Status::InvalidArguments);
+        return response;
+      }
+
       _currentDirectory = static_cast<Directory*>(node);
       response.setPrefixNewLine(false);
       response.setPostfixNewLine(false);
     }
     else
     {
-      auto* cmd = static_cast<CommandIf*>(node);
-      response = cmd->execute(request.getArgs());
+      response = executeCommand(*static_cast<CommandIf*>(node), request.getArgs());
+      applyOutputFilters(response, filters);
     }
 
-    if (!request.getPath().isEmpty())
+    // Script lines stay out of the history
+    if (!request.getPath().isEmpty() && _scriptDepth == 0)
     {
       _commandHistory.addCommand(request.getOriginalInput());
       _commandHistory.resetNavigation();
@@ -284,101 +615,282 @@ namespace cliService
   }
 
 
-  CLIResponse CLIService::handleGlobalCommand(const std::string_view& command, const std::vector<std::string>& args)
+  void CLIService::applyOutputFilters(CLIResponse& response, const std::vector<OutputFilter>& filters) const
   {
-    auto it = GLOBAL_COMMAND_HANDLERS.find(command);
+    // Errors are shown as they are, filtering could hide them
+    if (filters.empty() || response.getStatus() != CLIResponse::Status::Success) { return; }
 
-    if (it != GLOBAL_COMMAND_HANDLERS.end()) {
-      return (this->*(it->second))(args);
+    // Message and streamed lines become one stream, pulled through the
+    // filters while the response is written
+    std::shared_ptr<OutputSourceIf> source =
+      std::make_shared<MessageLineSource>(response.getMessage(), _messages.getNewLine(), response.getOutputSource());
+
+    for (const auto& filter : filters) {
+      source = filter.apply(std::move(source));
     }
 
-    return CLIResponse("Unknown command: " + std::string(command), CLIResponse::Status::Error);
+    response.setMessage(std::string());
+    response.setOutputSource(std::move(source));
   }
 
 
-  CLIResponse CLIService::handleRequest(const TabCompletionRequest& request)
+  CLIResponse CLIService::startJob(const CommandRequest& request, const std::vector<OutputFilter>& filters)
   {
     CLIResponse response = CLIResponse::success();
-    response.setShowPrompt(false);
-    response.setIndentMessage(false);
-    response.setInlineMessage(true);
-    response.setPrefixNewLine(false);
-    response.setPostfixNewLine(false);
-
-    auto currentInput = _inputParser.getBuffer();
+    const auto& path = request.getPath();
 
-    // Skip directory handling for paths with parent references
-    if (currentInput.find("..") == std::string::npos)
+    if (path.isEmpty() || GLOBAL_COMMAND_HANDLERS.find(path.elements().front()) != GLOBAL_COMMAND_HANDLERS.end())
     {
-      auto node = resolvePath(request.getPath());
-
-      if (node && node->isDirectory() && !currentInput.empty() && currentInput.back() != '/')
-      {
-        _inputParser.appendToBuffer("/", false);
-        response.appendToMessage(std::string("/"));
-        return response;
-      }
+      response.setStatus(CLIResponse::Status::InvalidArguments);
+      response.appendToMessage(std::string("Only commands in the tree can run in the background"));
+      return response;
     }
 
-    PathCompleter::CompletionResult result{};
+    NodeIf* node = resolvePath(path);
 
-    if (request.getPath().isAbsolute()) {
-      result = PathCompleter::complete(*getRootPtr(), currentInput, _currentUser->getAccessLevel());
+    if (!node)
+    {
+      response.setStatus(CLIResponse::Status::InvalidPath);
+      response.appendToMessage(_messages.getInvalidPathMessage());
+      return response;
     }
-    else {
-      result = PathCompleter::complete(*_currentDirectory, currentInput, _currentUser->getAccessLevel());
+
+    if (!validatePathAccess(node))
+    {
+      response.setStatus(CLIResponse::Status::AccessDenied);
+      response.appendToMessage(_messages.getAccessDeniedMessage());
+      return response;
     }
 
-    if (result.allOptions.size() > 1)
+    if (node->isDirectory())
     {
-      // Just display newline (we don't need to show original input since it's already shown)
-      response.appendToMessage(_messages.getNewLine());
+      response.setStatus(CLIResponse::Status::InvalidPath);
+      response.appendToMessage("Not a command: " + path.toString());
+      return response;
+    }
 
-      // Show all options
-      for (const auto& opt : result.allOptions) {
-        response.appendToMessage("   " + opt);
-      }
+    // Checked before the command runs, it would have nowhere to go
+    if (_jobs.getJobs().size() >= JobTable::MAX_JOBS)
+    {
+      response.setStatus(CLIResponse::Status::Error);
+      response.appendToMessage(std::string("Too many jobs, collect finished ones with 'fg'"));
+      return response;
+    }
 
-      response.appendToMessage(_messages.getNewLine());
-      response.appendToMessage(getPromptString()); // Show prompt with common prefix
-      response.setShowPrompt(false);
-      
-      if (!result.fillCharacters.empty())
-      {
-        _inputParser.appendToBuffer(result.fillCharacters, false);
-        response.appendToMessage(currentInput + result.fillCharacters);
-      }
-      else {
-        response.appendToMessage(currentInput);
-      }
+    std::string_view commandLine = request.getOriginalInput();
+    commandLine = commandLine.substr(0, commandLine.find_last_of('&'));
+
+    while (!commandLine.empty() && commandLine.back() == ' ') {
+      commandLine.remove_suffix(1);
     }
-    else if (!result.fillCharacters.empty())
+
+    // execute() runs on the job's first turn in the service loop, the prompt comes back first
+    auto start = [this, command = static_cast<CommandIf*>(node), args = request.getArgs(), filters](CLIResponse::Status& status) {
+      CLIResponse result = executeCommand(*command, args);
+      applyOutputFilters(result, filters);
+      status = result.getStatus();
+      return std::make_shared<MessageLineSource>(result.getMessage(), _messages.getNewLine(), result.getOutputSource());
+    };
+
+    const BackgroundJob* job = _jobs.start(std::string(commandLine), std::move(start));
+
+    if (_scriptDepth == 0)
     {
-      // For single match, just append completion
-      _inputParser.appendToBuffer(result.fillCharacters, false);
-      response.appendToMessage(result.fillCharacters);
-      
-      if (result.isDirectory)
-      {
-        _inputParser.appendToBuffer("/", false);
-        response.appendToMessage(std::string("/"));
-      }
+      _commandHistory.addCommand(request.getOriginalInput());
+      _commandHistory.resetNavigation();
     }
 
+    response.appendToMessage("[" + std::to_string(job->getId()) + "] " + job->getCommandLine());
     return response;
   }
 
 
-  CLIResponse CLIService::handleRequest(const HistoryNavigationRequest& request)
+  CLIResponse CLIService::handleBinaryRequest(uint32_t nodeId, const std::vector<std::string>& args)
   {
-    // First time pressing up, save current buffer
-    if (request.getDirection() == HistoryNavigationRequest::Direction::Previous &&
-        _commandHistory.getCurrentIndex() == _commandHistory.size())
-    {
-      _savedBuffer = request.getCurrentBuffer();
+    assert(_currentUser && "No user logged in");
+
+    if (nodeId == LEAVE_BINARY_MODE_ID) {
+      return CLIResponse::success(std::string(_machineMode ? "machine" : "human"));
     }
 
-    std::string historyCommand;
+    // Straight from the ID to the node, no path involved
+    CLIResponse response = CLIResponse::success();
+    NodeIf* node = getRootPtr()->findNodeById(nodeId);
+
+    if (!node)
+    {
+      response.appendToMessage(_messages.getInvalidPathMessage());
+      response.setStatus(CLIResponse::Status::InvalidPath);
+      return response;
+    }
+
+    if (!validatePathAccess(node))
+    {
+      response.appendToMessage(_messages.getAccessDeniedMessage());
+      response.setStatus(CLIResponse::Status::AccessDenied);
+      return response;
+    }
+
+    if (node->isDirectory())
+    {
+      _currentDirectory = static_cast<Directory*>(node);
+      return response;
+    }
+
+    return executeCommand(*static_cast<CommandIf*>(node), args);
+  }
+
+
+  CLIResponse CLIService::executeCommand(CommandIf& cmd, const std::vector<std::string>& args)
+  {
+    TraceScope trace(_tracer, &_clock, TracePhase::Execute, cmd.getName());
+
+    const uint64_t start_us = _clock.now_us();
+    CLIResponse response = cmd.execute(args);
+    cmd.getMetrics().record(_clock.now_us() - start_us, response.getStatus() != CLIResponse::Status::Success);
+
+    return response;
+  }
+
+
+  CLIResponse CLIService::handleRequest(const PagerRequest& request)
+  {
+    // Everything is written here, the returned response adds nothing
+    CLIResponse response = CLIResponse::success();
+    response.setShowPrompt(false);
+    response.setIndentMessage(false);
+    response.setInlineMessage(true);
+    response.setPrefixNewLine(false);
+    response.setPostfixNewLine(false);
+
+    if (!_pagedOutput)
+    {
+      _inputParser.setPagerMode(false);
+      return response;
+    }
+
+    // Blank out the more prompt
+    writeOutput("\r");
+    for (size_t i = 0; i < _messages.getMorePrompt().length(); ++i) {
+      writeOutput(" ");
+    }
+    writeOutput("\r");
+
+    switch (request.getAction())
+    {
+      case PagerRequest::Action::NextPage:
+        writePage(_pageHeight);
+        break;
+
+      case PagerRequest::Action::NextLine:
+        writePage(1);
+        break;
+
+      case PagerRequest::Action::Quit:
+      default:
+        endPaging();
+        break;
+    }
+
+    return response;
+  }
+
+
+  CLIResponse CLIService::handleGlobalCommand(const std::string_view& command, const std::vector<std::string>& args)
+  {
+    auto it = GLOBAL_COMMAND_HANDLERS.find(command);
+
+    if (it != GLOBAL_COMMAND_HANDLERS.end()) {
+      return (this->*(it->second))(args);
+    }
+
+    return CLIResponse("Unknown command: " + std::string(command), CLIResponse::Status::Error);
+  }
+
+
+  CLIResponse CLIService::handleRequest(const TabCompletionRequest& request)
+  {
+    CLIResponse response = CLIResponse::success();
+    response.setShowPrompt(false);
+    response.setIndentMessage(false);
+    response.setInlineMessage(true);
+    response.setPrefixNewLine(false);
+    response.setPostfixNewLine(false);
+
+    auto currentInput = _inputParser.getBuffer();
+
+    // Skip directory handling for paths with parent references
+    if (currentInput.find("..") == std::string::npos)
+    {
+      auto node = resolvePath(request.getPath());
+
+      if (node && node->isDirectory() && !currentInput.empty() && currentInput.back() != '/')
+      {
+        _inputParser.appendToBuffer("/", false);
+        response.appendToMessage(std::string("/"));
+        return response;
+      }
+    }
+
+    PathCompleter::CompletionResult result{};
+
+    if (request.getPath().isAbsolute()) {
+      result = PathCompleter::complete(*getRootPtr(), currentInput, _currentUser->getAccessLevel());
+    }
+    else {
+      result = PathCompleter::complete(*_currentDirectory, currentInput, _currentUser->getAccessLevel());
+    }
+
+    if (result.allOptions.size() > 1)
+    {
+      // Just display newline (we don't need to show original input since it's already shown)
+      response.appendToMessage(_messages.getNewLine());
+
+      // Show all options
+      for (const auto& opt : result.allOptions) {
+        response.appendToMessage("   " + opt);
+      }
+
+      response.appendToMessage(_messages.getNewLine());
+      response.appendToMessage(getPromptString()); // Show prompt with common prefix
+      response.setShowPrompt(false);
+      
+      if (!result.fillCharacters.empty())
+      {
+        _inputParser.appendToBuffer(result.fillCharacters, false);
+        response.appendToMessage(currentInput + result.fillCharacters);
+      }
+      else {
+        response.appendToMessage(currentInput);
+      }
+    }
+    else if (!result.fillCharacters.empty())
+    {
+      // For single match, just append completion
+      _inputParser.appendToBuffer(result.fillCharacters, false);
+      response.appendToMessage(result.fillCharacters);
+      
+      if (result.isDirectory)
+      {
+        _inputParser.appendToBuffer("/", false);
+        response.appendToMessage(std::string("/"));
+      }
+    }
+
+    return response;
+  }
+
+
+  CLIResponse CLIService::handleRequest(const HistoryNavigationRequest& request)
+  {
+    // First time pressing up, save current buffer
+    if (request.getDirection() == HistoryNavigationRequest::Direction::Previous &&
+        _commandHistory.getCurrentIndex() == _commandHistory.size())
+    {
+      _savedBuffer = request.getCurrentBuffer();
+    }
+
+    std::string historyCommand;
 
     if (request.getDirection() == HistoryNavigationRequest::Direction::Previous) {
       historyCommand = _commandHistory.getPreviousCommand();
@@ -418,10 +930,16 @@ namespace cliService
     else
     {
       response.appendToMessage("help   - List global commands" + std::string(_messages.getNewLine()));
-      response.appendToMessage("tree   - Print directory tree" + std::string(_messages.getNewLine()));
+      response.appendToMessage("tree   - Print directory tree ('tree [path] [-L depth] [-i]', -i shows node IDs)" + std::string(_messages.getNewLine()));
       response.appendToMessage("?      - Detail items in current directory" + std::string(_messages.getNewLine()));
       response.appendToMessage("logout - Exit current session" + std::string(_messages.getNewLine()));
       response.appendToMessage("clear  - Clear screen" + std::string(_messages.getNewLine()));
+      response.appendToMessage("stats  - Show command statistics ('stats reset' clears them)" + std::string(_messages.getNewLine()));
+      response.appendToMessage("mode   - Show or set output mode ('mode human', 'mode machine' or 'mode binary')" + std::string(_messages.getNewLine()));
+      response.appendToMessage("source - Run a script ('source [-e] [-q] <name>', -e stops on error, -q hides prompts)" + std::string(_messages.getNewLine()));
+      response.appendToMessage("watch  - Rerun a command periodically ('watch [-n seconds] <command>', any key stops)" + std::string(_messages.getNewLine()));
+      response.appendToMessage("jobs   - List background jobs, started by ending a command line with '&'" + std::string(_messages.getNewLine()));
+      response.appendToMessage("fg     - Show the output of a background job ('fg [N]', the latest by default)" + std::string(_messages.getNewLine()));
       response.appendToMessage("exit   - Exit the CLI" + std::string(_messages.getNewLine(0)));
     }
 
@@ -432,22 +950,94 @@ namespace cliService
   {
     CLIResponse response = CLIResponse::success();
 
-    if (!args.empty())
+    // tree [path] [-L depth] [-i]
+    std::optional<std::string_view> pathArg;
+    size_t maxDepth = TreeOutputSource::UNLIMITED_DEPTH;
+    bool showIds = false;
+
+    for (size_t i = 0; i < args.size(); ++i)
     {
-      response.setStatus(CLIResponse::Status::InvalidArguments);
-      response.appendToMessage(std::string(_messages.getNoArgumentsMessage()));
+      if (args[i] == "-L" && i + 1 < args.size() && parseDepth(args[i + 1], maxDepth))
+      {
+        i++;
+        continue;
+      }
+
+      if (args[i] == "-i")
+      {
+        showIds = true;
+        continue;
+      }
+
+      if (args[i].front() == '-' || pathArg)
+      {
+        response.setStatus(CLIResponse::Status::InvalidArguments);
+        response.appendToMessage(std::string("Usage: tree [path] [-L depth] [-i]"));
+        return response;
+      }
+
+      pathArg = args[i];
     }
-    else
+
+    const Directory* start = _currentDirectory;
+
+    if (pathArg)
     {
-      std::string nodeList = getNodeListDisplay(NodeDisplayMode::Tree, false);
-      response.appendToMessage(nodeList);
-      response.setPostfixNewLine(false);
+      NodeIf* node = resolvePath(Path(*pathArg));
+
+      if (!node)
+      {
+        response.setStatus(CLIResponse::Status::InvalidPath);
+        response.appendToMessage(_messages.getInvalidPathMessage());
+        return response;
+      }
+
+      if (!validatePathAccess(node))
+      {
+        response.setStatus(CLIResponse::Status::AccessDenied);
+        response.appendToMessage(_messages.getAccessDeniedMessage());
+        return response;
+      }
+
+      if (!node->isDirectory())
+      {
+        response.setStatus(CLIResponse::Status::InvalidPath);
+        response.appendToMessage(std::string("Not a directory: ") + std::string(*pathArg));
+        return response;
+      }
+
+      start = static_cast<const Directory*>(node);
     }
 
+    // Rendered while the response is written, never as a whole, and nothing
+    // below the depth limit is visited
+    auto source = std::make_shared<TreeOutputSource>(*start, _currentUser->getAccessLevel(), false, maxDepth);
+    source->setShowIds(showIds);
+    response.setOutputSource(std::move(source));
+
     return response;
   }
 
 
+  bool CLIService::parseDepth(std::string_view text, size_t& depth)
+  {
+    if (text.empty()) { return false; }
+
+    size_t value = 0;
+
+    for (char c : text)
+    {
+      if (c < '0' || c > '9') { return false; }
+      value = value * 10 + static_cast<size_t>(c - '0');
+
+      if (value > MAX_TREE_DEPTH) { return false; }
+    }
+
+    depth = value;
+    return true;
+  }
+
+
   CLIResponse CLIService::handleGlobalQuestionMark(const std::vector<std::string>& args)
   {
     CLIResponse response = CLIResponse::success();
@@ -481,6 +1071,7 @@ namespace cliService
     {
       _currentCLIState = CLIState::LoggedOut;
       _currentUser = std::nullopt;
+      clearSessionState();
       resetToRoot();
       response.appendToMessage(_messages.getLoggedOutMessage());
     }
@@ -511,79 +1102,917 @@ namespace cliService
   }
 
 
-  CLIResponse CLIService::handleGlobalExit(const std::vector<std::string>& args)
+  CLIResponse CLIService::handleGlobalStats(const std::vector<std::string>& args)
   {
     CLIResponse response = CLIResponse::success();
 
-    if (!args.empty())
+    if (args.size() == 1 && args.front() == "reset")
+    {
+      // Counters of commands hidden from this user are left alone
+      resetMetrics(_currentUser->getAccessLevel());
+      response.appendToMessage(std::string("Statistics reset"));
+    }
+    else if (!args.empty())
     {
       response.setStatus(CLIResponse::Status::InvalidArguments);
-      response.appendToMessage(std::string(_messages.getNoArgumentsMessage()));
+      response.appendToMessage(std::string("Usage: stats [reset]"));
     }
     else
     {
-      _currentCLIState = CLIState::Inactive;
-      _currentUser = std::nullopt;
-      resetToRoot();
-      response.appendToMessage(std::string(_messages.getExitMessage()));
-      response.setShowPrompt(false);
+      // Only report commands this user could run
+      response.appendToMessage(formatMetrics(collectMetrics(_currentUser->getAccessLevel()), "command"));
+
+#if CLISERVICE_LATENCY_STATS
+      std::vector<CommandMetricsSnapshot> latencies;
+
+      for (size_t kind = 0; kind < LatencyStats::KIND_COUNT; ++kind)
+      {
+        const auto& stats = _latencyStats.get(static_cast<LatencyStats::Kind>(kind));
+
+        if (stats.getInvocations() > 0) {
+          latencies.push_back({LatencyStats::getName(static_cast<LatencyStats::Kind>(kind)), stats});
+        }
+      }
+
+      if (!latencies.empty())
+      {
+        response.appendToMessage(_messages.getNewLine(2));
+        response.appendToMessage(formatMetrics(latencies, "input"));
+      }
+#endif
+
+      if (_txScheduler.isPaced())
+      {
+        const std::string newLine(_messages.getNewLine());
+
+        response.appendToMessage(_messages.getNewLine(2));
+        response.appendToMessage("tx: " + std::to_string(_txScheduler.getBytesPerSecond()) + " bytes/s, "
+          + std::to_string(_txScheduler.getSentCount()) + " bytes sent" + newLine);
+        response.appendToMessage("queued: interactive " + std::to_string(_txScheduler.getQueueDepth(TxPriority::Interactive))
+          + " (peak " + std::to_string(_txScheduler.getPeakQueueDepth(TxPriority::Interactive)) + ")"
+          + ", bulk " + std::to_string(_txScheduler.getQueueDepth(TxPriority::Bulk))
+          + " (peak " + std::to_string(_txScheduler.getPeakQueueDepth(TxPriority::Bulk)) + ")");
+      }
     }
 
     return response;
   }
 
 
-  void CLIService::handleOutput(const CLIResponse& response)
+  CLIResponse CLIService::handleGlobalMode(const std::vector<std::string>& args)
   {
-    if (response.prefixNewLine()) {
-      _ioStream.putString(_messages.getNewLine());
-    }
+    CLIResponse response = CLIResponse::success();
 
-    auto lineList = splitString(response.getMessage(), std::string(_messages.getNewLine()));
+    if (args.empty())
+    {
+      response.appendToMessage(std::string(_machineMode ? "machine" : "human"));
+      return response;
+    }
 
-    for (uint32_t idx = 0; idx < lineList.size(); ++idx)
+    if (args.size() != 1 || (args.front() != "human" && args.front() != "machine" && args.front() != "binary"))
     {
-      if (response.indentMessage()) {
-        _ioStream.putString(std::string(_messages.getIndentation()));
-      }
+      response.setStatus(CLIResponse::Status::InvalidArguments);
+      response.appendToMessage(std::string("Usage: mode [human|machine|binary]"));
+      return response;
+    }
 
-      _ioStream.putString(lineList[idx]);
+    response.appendToMessage("Output mode: " + args.front());
 
-      if (idx < lineList.size() - 1 || !response.inlineMessage()) {
-        _ioStream.putString(_messages.getNewLine());
-      }
+    // Takes effect with this response already, binary mode returns to the
+    // current text mode when left
+    if (args.front() == "binary")
+    {
+      _binaryMode = true;
+      return response;
     }
 
-    if (response.postfixNewLine()) {
-      _ioStream.putString(_messages.getNewLine());
-    }
+    _machineMode = args.front() == "machine";
+    _inputParser.setMachineMode(_machineMode);
 
-    if (response.showPrompt()) {
-      _ioStream.putString(getPromptString());
-    }
+    return response;
   }
 
 
-  std::vector<std::string> CLIService::splitString(const std::string& str, const std::string& delimiter)
+  CLIResponse CLIService::handleGlobalSource(const std::vector<std::string>& args)
   {
-    std::vector<std::string> substrings;
-    if (str.empty()) { return substrings; }
+    CLIResponse response = CLIResponse::success();
+
+    // source [-e] [-q] <name>
+    ScriptOptions options;
+    std::optional<std::string_view> name;
+    bool valid = true;
+
+    for (const auto& arg : args)
+    {
+      if (arg == "-e") {
+        options.stopOnError = true;
+      }
+      else if (arg == "-q") {
+        options.showPrompts = false;
+      }
+      else if (arg.front() != '-' && !name) {
+        name = arg;
+      }
+      else {
+        valid = false;
+      }
+    }
 
-    assert(!delimiter.empty() && "Delimiter cannot be empty");
+    if (!valid || !name)
+    {
+      response.setStatus(CLIResponse::Status::InvalidArguments);
+      response.appendToMessage(std::string("Usage: source [-e] [-q] <name>"));
+      return response;
+    }
 
-    size_t start = 0;
-    size_t end = str.find(delimiter);
+    if (!_scriptLoader)
+    {
+      response.setStatus(CLIResponse::Status::Error);
+      response.appendToMessage(std::string("Scripts are not supported"));
+      return response;
+    }
 
-    while (end != std::string::npos)
+    // Scripts echo their lines, reading them is up to the host's choice of level
+    if (_scriptAccessLevel && _currentUser->getAccessLevel() < *_scriptAccessLevel)
     {
-      substrings.push_back(str.substr(start, end - start));
-      start = end + delimiter.length();
-      end = str.find(delimiter, start);
+      response.setStatus(CLIResponse::Status::AccessDenied);
+      response.appendToMessage(_messages.getAccessDeniedMessage());
+      return response;
     }
 
-    substrings.push_back(str.substr(start));
+    if (_scriptDepth >= MAX_SCRIPT_DEPTH)
+    {
+      response.setStatus(CLIResponse::Status::Error);
+      response.appendToMessage(std::string("Scripts nested too deeply"));
+      return response;
+    }
+
+    std::string script;
+
+    if (!_scriptLoader->load(*name, script))
+    {
+      response.setStatus(CLIResponse::Status::InvalidPath);
+      response.appendToMessage("Script not found: " + std::string(*name));
+      return response;
+    }
+
+    const ScriptResult result = runScript(script, options);
+
+    response.appendToMessage(std::to_string(result.executed) + " commands, " + std::to_string(result.failed) + " failed");
+
+    if (result.stoppedAtLine > 0) {
+      response.appendToMessage(", stopped at line " + std::to_string(result.stoppedAtLine));
+    }
+
+    if (result.failed > 0) {
+      response.setStatus(CLIResponse::Status::Error);
+    }
+
+    return response;
+  }
+
+
+  CLIResponse CLIService::handleGlobalWatch(const std::vector<std::string>& args)
+  {
+    CLIResponse response = CLIResponse::success();
+
+    // watch [-n seconds] <command> [args]
+    uint64_t interval_ms = DEFAULT_WATCH_INTERVAL_MS;
+    std::string_view intervalText = "2";
+    size_t commandIndex = 0;
+
+    if (!args.empty() && args[0] == "-n")
+    {
+      if (args.size() < 2 || !parseInterval(args[1], interval_ms))
+      {
+        response.setStatus(CLIResponse::Status::InvalidArguments);
+        response.appendToMessage(std::string("Interval must be 0.1 to 86400 seconds"));
+        return response;
+      }
+
+      intervalText = args[1];
+      commandIndex = 2;
+    }
+
+    if (commandIndex >= args.size())
+    {
+      response.setStatus(CLIResponse::Status::InvalidArguments);
+      response.appendToMessage(std::string("Usage: watch [-n seconds] <command>"));
+      return response;
+    }
+
+    // Cursor positioning only makes sense on a terminal, and a script would never get past it
+    if (_machineMode || _scriptDepth > 0)
+    {
+      response.setStatus(CLIResponse::Status::Error);
+      response.appendToMessage(std::string("watch needs an interactive terminal"));
+      return response;
+    }
+
+    const Path path(args[commandIndex]);
+
+    if (!path.isEmpty() && GLOBAL_COMMAND_HANDLERS.find(path.elements().front()) != GLOBAL_COMMAND_HANDLERS.end())
+    {
+      response.setStatus(CLIResponse::Status::InvalidArguments);
+      response.appendToMessage(std::string("Only commands in the tree can be watched"));
+      return response;
+    }
+
+    NodeIf* node = resolvePath(path);
+
+    if (!node)
+    {
+      response.setStatus(CLIResponse::Status::InvalidPath);
+      response.appendToMessage(_messages.getInvalidPathMessage());
+      return response;
+    }
+
+    if (!validatePathAccess(node))
+    {
+      response.setStatus(CLIResponse::Status::AccessDenied);
+      response.appendToMessage(_messages.getAccessDeniedMessage());
+      return response;
+    }
+
+    if (node->isDirectory())
+    {
+      response.setStatus(CLIResponse::Status::InvalidPath);
+      response.appendToMessage("Not a command: " + args[commandIndex]);
+      return response;
+    }
+
+    _watch.emplace(static_cast<CommandIf*>(node), std::vector<std::string>(args.begin() + commandIndex + 1, args.end()),
+                   interval_ms * 1000, _clock.now_us());
+
+    // Terminals sending a bare LF or CR for Enter stop it with their first one
+    _watch->skipLineFeed = _inputParser.endedWithCr();
+
+    // Header, the lines are drawn below it by the service loop
+    response.appendToMessage(std::string("\033[2J\033[H"));
+    response.appendToMessage("Every " + std::string(intervalText) + "s:");
+
+    for (size_t i = commandIndex; i < args.size(); ++i) {
+      response.appendToMessage(" " + args[i]);
+    }
+
+    response.setIndentMessage(false);
+    response.setPrefixNewLine(false);
+    response.setPostfixNewLine(false);
+    response.setShowPrompt(false);
+
+    return response;
+  }
+
+
+  bool CLIService::parseInterval(std::string_view text, uint64_t& interval_ms)
+  {
+    // Decimal seconds with up to three fractional digits
+    uint64_t value = 0;
+    size_t fractionDigits = 0;
+    bool inFraction = false;
+    bool haveDigit = false;
+
+    for (char c : text)
+    {
+      if (c == '.' && !inFraction)
+      {
+        inFraction = true;
+        continue;
+      }
+
+      if (c < '0' || c > '9' || fractionDigits == 3) { return false; }
+
+      value = value * 10 + static_cast<uint64_t>(c - '0');
+      haveDigit = true;
+
+      if (inFraction) { fractionDigits++; }
+      if (value > MAX_WATCH_INTERVAL_MS) { return false; }
+    }
+
+    for (; fractionDigits < 3; ++fractionDigits) {
+      value *= 10;
+    }
+
+    if (!haveDigit || value < MIN_WATCH_INTERVAL_MS || value > MAX_WATCH_INTERVAL_MS) { return false; }
+
+    interval_ms = value;
+    return true;
+  }
+
+
+  void CLIService::serviceWatch()
+  {
+    char c;
+
+    while (_ioStream.available() && _ioStream.getChar(c))
+    {
+      if (c == InputParser::ENTER_LF && _watch->skipLineFeed)
+      {
+        _watch->skipLineFeed = false;
+        continue;
+      }
+
+      stopWatch();
+      return;
+    }
+
+    // Refreshes never queue up behind a previous one still being sent
+    if (isDrainingOutput() || !_txScheduler.isIdle()) { return; }
+
+    const uint64_t now_us = _clock.now_us();
+    if (now_us < _watch->nextRun_us) { return; }
+
+    // Keep the cadence, unless refreshes fell behind by more than an interval
+    _watch->nextRun_us += _watch->interval_us;
+
+    if (_watch->nextRun_us <= now_us) {
+      _watch->nextRun_us = now_us + _watch->interval_us;
+    }
+
+    refreshWatch();
+  }
+
+
+  void CLIService::refreshWatch()
+  {
+    auto& watch = *_watch;
+
+    CLIResponse response = executeCommand(*watch.command, watch.args);
+    applyOutputFilters(response, watch.filters);
+
+    // Only as many lines as fit below the header
+    const size_t maxLines = _pageHeight > WATCH_HEADER_ROWS ? _pageHeight - WATCH_HEADER_ROWS : MAX_WATCH_LINES;
+    MessageLineSource source(response.getMessage(), _messages.getNewLine(), response.getOutputSource());
+    size_t count = 0;
+
+    while (count < maxLines && source.nextLine(_lineBuffer))
+    {
+      if (count == watch.lines.size()) {
+        watch.lines.emplace_back();
+      }
+
+      watch.lines[count++].swap(_lineBuffer);
+    }
+
+    watch.lines.resize(count);
+
+    watch.output.clear();
+    watch.view.update(watch.lines, watch.output);
+
+    writeOutput(watch.output);
+    flushOutput();
+  }
+
+
+  void CLIService::stopWatch()
+  {
+    std::string output;
+    _watch->view.moveBelow(output);
+    _watch.reset();
+
+    writeOutput(output);
+    writeOutput(_messages.getNewLine());
+    writeOutput(getPromptString());
+    flushOutput();
+    _txScheduler.fence();
+  }
+
+
+  CLIResponse CLIService::handleGlobalJobs(const std::vector<std::string>& args)
+  {
+    CLIResponse response = CLIResponse::success();
+
+    if (!args.empty())
+    {
+      response.setStatus(CLIResponse::Status::InvalidArguments);
+      response.appendToMessage(std::string(_messages.getNoArgumentsMessage()));
+      return response;
+    }
+
+    if (_jobs.getJobs().empty())
+    {
+      response.appendToMessage(std::string("No jobs"));
+      return response;
+    }
+
+    const std::string newLine(_messages.getNewLine());
+    bool first = true;
+
+    for (const auto& job : _jobs.getJobs())
+    {
+      if (!first) { response.appendToMessage(newLine); }
+      first = false;
+
+      const char* state = job.isRunning() ? "Running" :
+                          job.getStatus() == CLIResponse::Status::Success ? "Done   " : "Failed ";
+
+      response.appendToMessage("[" + std::to_string(job.getId()) + "] " + state + "  " + job.getCommandLine() +
+                               "  (" + std::to_string(job.getBufferedLines()) + " lines");
+
+      if (job.getDroppedLines() > 0) {
+        response.appendToMessage(", " + std::to_string(job.getDroppedLines()) + " dropped");
+      }
+
+      response.appendToMessage(std::string(")"));
+    }
+
+    return response;
+  }
+
+
+  CLIResponse CLIService::handleGlobalFg(const std::vector<std::string>& args)
+  {
+    CLIResponse response = CLIResponse::success();
+
+    // fg [N]
+    const bool validId = args.size() == 1 && !args[0].empty() && args[0].length() <= 9 &&
+                         std::all_of(args[0].begin(), args[0].end(), [](char c) { return c >= '0' && c <= '9'; });
+
+    if (args.size() > 1 || (args.size() == 1 && !validId))
+    {
+      response.setStatus(CLIResponse::Status::InvalidArguments);
+      response.appendToMessage(std::string("Usage: fg [N]"));
+      return response;
+    }
+
+    BackgroundJob* job = args.empty() ? _jobs.latest() : _jobs.find(static_cast<uint32_t>(std::stoul(args[0])));
+
+    if (!job)
+    {
+      response.setStatus(CLIResponse::Status::Error);
+      response.appendToMessage(std::string("No such job"));
+      return response;
+    }
+
+    // Buffered lines first, a job still running finishes in the foreground
+    response.setOutputSource(job->takeOutput());
+    response.setStatus(job->getStatus());
+    _jobs.remove(job->getId());
+
+    return response;
+  }
+
+
+  ScriptResult CLIService::runScript(std::string_view script, const ScriptOptions& options)
+  {
+    assert(_currentCLIState == CLIState::LoggedIn && "Scripts run as the logged in user");
+
+    ScriptResult result;
+    const std::string_view newLine = _messages.getNewLine();
+    const bool showPrompts = options.showPrompts && !_machineMode;
+
+    size_t lineNumber = 0;
+    _scriptDepth++;
+
+    while (!script.empty())
+    {
+      const size_t end = script.find('\n');
+      std::string_view line = script.substr(0, end);
+      script.remove_prefix(end == std::string_view::npos ? script.length() : end + 1);
+      lineNumber++;
+
+      // Tolerate CRLF files and indentation
+      while (!line.empty() && std::isspace(static_cast<unsigned char>(line.back()))) { line.remove_suffix(1); }
+      while (!line.empty() && std::isspace(static_cast<unsigned char>(line.front()))) { line.remove_prefix(1); }
+
+      if (line.empty() || line.front() == '#') { continue; }
+
+      if (showPrompts)
+      {
+        writeOutput(getPromptString());
+        writeOutput(line);
+        writeOutput(newLine);
+      }
+
+      const auto request = InputParser::parseToCommandRequest(line);
+      CLIResponse response = handleRequest(*request);
+      response.setShowPrompt(false);
+
+      // Written right away, a script never waits for pager keys
+      handleOutput(response, false);
+
+      result.executed++;
+
+      if (response.getStatus() != CLIResponse::Status::Success)
+      {
+        result.failed++;
+
+        if (options.stopOnError)
+        {
+          result.stoppedAtLine = lineNumber;
+          break;
+        }
+      }
+
+      // Logged out or exited by the script itself
+      if (_currentCLIState != CLIState::LoggedIn)
+      {
+        result.stoppedAtLine = script.empty() ? 0 : lineNumber;
+        break;
+      }
+    }
+
+    _scriptDepth--;
+    flushOutput();
+
+    return result;
+  }
+
+
+  std::vector<CommandMetricsSnapshot> CLIService::getMetricsSnapshot() const {
+    return collectMetrics(std::nullopt);
+  }
+
+
+  std::vector<CommandMetricsSnapshot> CLIService::collectMetrics(std::optional<AccessLevel> maxLevel) const
+  {
+    std::vector<CommandMetricsSnapshot> snapshot;
+
+    getRootPtr()->visit([&](const NodeIf& node, size_t) {
+      if (maxLevel && node.getEffectiveAccessLevel() > *maxLevel) { return TraversalAction::SkipChildren; }
+      if (node.isDirectory()) { return TraversalAction::Continue; }
+
+      const auto& metrics = static_cast<const CommandIf&>(node).getMetrics();
+
+      if (metrics.getInvocations() > 0) {
+        snapshot.push_back({_pathResolver.getAbsolutePath(node).toString(), metrics});
+      }
+
+      return TraversalAction::Continue;
+    });
+
+    return snapshot;
+  }
+
+
+  void CLIService::resetMetrics()
+  {
+    resetMetrics(std::nullopt);
+  }
+
+
+  void CLIService::resetMetrics(std::optional<AccessLevel> maxLevel)
+  {
+    getRootPtr()->visit([&](const NodeIf& node, size_t) {
+      if (maxLevel && node.getEffectiveAccessLevel() > *maxLevel) { return TraversalAction::SkipChildren; }
+
+      if (!node.isDirectory()) {
+        static_cast<const CommandIf&>(node).getMetrics().reset();
+      }
+
+      return TraversalAction::Continue;
+    });
+  }
+
+
+  std::string CLIService::formatMetrics(const std::vector<CommandMetricsSnapshot>& snapshot, std::string_view title) const
+  {
+    if (snapshot.empty()) { return "No commands executed yet"; }
+
+    size_t pathWidth = title.length();
+    for (const auto& entry : snapshot) {
+      pathWidth = std::max(pathWidth, entry.path.length());
+    }
+
+    auto pad = [](std::string text, size_t width, bool alignRight) {
+      if (text.length() < width) {
+        text.insert(alignRight ? 0 : text.length(), width - text.length(), ' ');
+      }
+      return text;
+    };
+
+    constexpr size_t COLUMN_WIDTH = 9;
+    std::string text = pad(std::string(title), pathWidth, false);
+
+    for (const char* column : {"calls", "errors", "avg_us", "p50_us", "p99_us", "max_us"}) {
+      text += pad(column, COLUMN_WIDTH, true);
+    }
+
+    for (const auto& entry : snapshot)
+    {
+      const auto& metrics = entry.metrics;
+      text += _messages.getNewLine();
+      text += pad(entry.path, pathWidth, false);
+
+      for (uint64_t value : {uint64_t(metrics.getInvocations()), uint64_t(metrics.getErrors()),
+                             metrics.getAverageLatency_us(), metrics.getPercentileLatency_us(50),
+                             metrics.getPercentileLatency_us(99), metrics.getMaxLatency_us()}) {
+        text += pad(std::to_string(value), COLUMN_WIDTH, true);
+      }
+    }
+
+    return text;
+  }
+
+
+  CLIResponse CLIService::handleGlobalExit(const std::vector<std::string>& args)
+  {
+    CLIResponse response = CLIResponse::success();
+
+    if (!args.empty())
+    {
+      response.setStatus(CLIResponse::Status::InvalidArguments);
+      response.appendToMessage(std::string(_messages.getNoArgumentsMessage()));
+    }
+    else
+    {
+      _currentCLIState = CLIState::Inactive;
+      _currentUser = std::nullopt;
+      clearSessionState();
+      resetToRoot();
+      response.appendToMessage(std::string(_messages.getExitMessage()));
+      response.setShowPrompt(false);
+    }
+
+    return response;
+  }
+
+
+  void CLIService::handleOutput(const CLIResponse& response, bool allowDeferral)
+  {
+    TraceScope trace(_tracer, &_clock, TracePhase::Render);
+
+    if (_binaryMode)
+    {
+      writeBinaryFrame(response);
+      return;
+    }
+
+    if (_machineMode)
+    {
+      writeFrame(response);
+      return;
+    }
+
+    const std::string_view newLine = _messages.getNewLine();
+    const std::string_view indentation = response.indentMessage() ? _messages.getIndentation() : std::string_view();
+
+    if (response.prefixNewLine()) {
+      writeOutput(newLine);
+    }
+
+    // Inline responses (completions, history) are short and never paged
+    if (allowDeferral && (_pageHeight > 0 || _txScheduler.isPaced()) && !response.inlineMessage())
+    {
+      _pagedOutput.emplace(PagedOutput{response});
+      writePage(_pageHeight > 0 ? _pageHeight : UNLIMITED_LINES);
+      return;
+    }
+
+    size_t offset = 0;
+    std::string_view line;
+
+    while (nextMessageLine(response.getMessage(), offset, newLine, line))
+    {
+      writeOutput(indentation);
+      writeOutput(line);
+
+      if (offset != std::string::npos || !response.inlineMessage()) {
+        writeOutput(newLine);
+      }
+    }
+
+    if (const auto& source = response.getOutputSource())
+    {
+      while (source->nextLine(_lineBuffer))
+      {
+        writeOutput(indentation);
+        writeOutput(_lineBuffer);
+        writeOutput(newLine);
+      }
+    }
+
+    finishOutput(response);
+  }
+
+
+  void CLIService::finishOutput(const CLIResponse& response)
+  {
+    if (response.postfixNewLine()) {
+      writeOutput(_messages.getNewLine());
+    }
+
+    if (response.showPrompt()) {
+      writeOutput(getPromptString());
+    }
+
+    // Echo of keys typed from now on belongs after this output, e.g. behind
+    // the prompt or the text a Tab completion filled in
+    flushOutput();
+    _txScheduler.fence();
+  }
+
+
+  bool CLIService::nextMessageLine(const std::string& message, size_t& offset, std::string_view newLine, std::string_view& line)
+  {
+    // Every line, including an empty one after a trailing line break
+    if (offset == std::string::npos || message.empty()) { return false; }
+
+    const size_t end = message.find(newLine, offset);
+
+    if (end == std::string::npos)
+    {
+      line = std::string_view(message).substr(offset);
+      offset = std::string::npos;
+    }
+    else
+    {
+      line = std::string_view(message).substr(offset, end - offset);
+      offset = end + newLine.length();
+    }
+
+    return true;
+  }
+
+
+  void CLIService::writePage(size_t lineCount)
+  {
+    _pagedOutput->linesLeft = lineCount;
+    continueOutput();
+  }
+
+
+  void CLIService::continueOutput()
+  {
+    const std::string_view newLine = _messages.getNewLine();
+    const std::string_view indentation = _pagedOutput->response.indentMessage() ? _messages.getIndentation() : std::string_view();
+
+    while (_pagedOutput->linesLeft > 0)
+    {
+      // The rest follows from service() once the link caught up
+      if (!hasOutputSpace())
+      {
+        flushOutput();
+        return;
+      }
+
+      if (!nextPagedLine())
+      {
+        endPaging();
+        return;
+      }
+
+      writeOutput(indentation);
+      writeOutput(_lineBuffer);
+      writeOutput(newLine);
+
+      if (_pagedOutput->linesLeft != UNLIMITED_LINES) {
+        _pagedOutput->linesLeft--;
+      }
+    }
+
+    // Only stop if there is more to come
+    if (!nextPagedLine())
+    {
+      endPaging();
+      return;
+    }
+
+    _pagedOutput->hasLookahead = true;
+    writeOutput(_messages.getMorePrompt());
+    flushOutput();
+    _inputParser.setPagerMode(true);
+  }
+
+
+  bool CLIService::hasOutputSpace() const
+  {
+    // Room for the staged output plus one more full buffer, longer lines
+    // may still push the oldest queued bytes out early
+    const size_t freeSpace = _txScheduler.getFreeSpace(TxPriority::Bulk);
+    return freeSpace == TxScheduler::UNLIMITED_SPACE || freeSpace >= _outputBuffer.length() + OUTPUT_BUFFER_CAPACITY;
+  }
+
+
+  bool CLIService::nextPagedLine()
+  {
+    auto& paged = *_pagedOutput;
+
+    if (paged.hasLookahead)
+    {
+      paged.hasLookahead = false;
+      return true;
+    }
+
+    std::string_view line;
+
+    if (nextMessageLine(paged.response.getMessage(), paged.messageOffset, _messages.getNewLine(), line))
+    {
+      _lineBuffer.assign(line);
+      return true;
+    }
+
+    const auto& source = paged.response.getOutputSource();
+    return source && source->nextLine(_lineBuffer);
+  }
+
+
+  void CLIService::endPaging()
+  {
+    _inputParser.setPagerMode(false);
+
+    CLIResponse response = std::move(_pagedOutput->response);
+    const bool typedAhead = _pagedOutput->typedAhead;
+    _pagedOutput.reset();
+
+    finishOutput(response);
+
+    // Keys typed while the output drained were echoed in between, repeat
+    // them after the prompt
+    if (typedAhead && response.showPrompt())
+    {
+      writeOutput(_inputParser.getBuffer());
+      flushOutput();
+      _txScheduler.fence();
+    }
+  }
+
+
+  void CLIService::writeFrame(const CLIResponse& response)
+  {
+    const std::string_view body = collectResponseBody(response);
+
+    writeOutput(std::to_string(static_cast<int>(response.getStatus())));
+    writeOutput(" ");
+    writeOutput(std::to_string(body.length()));
+    writeOutput(_messages.getNewLine());
+    writeOutput(body);
+    flushOutput();
+
+    _frameBuffer.clear();
+  }
+
+
+  void CLIService::writeBinaryFrame(const CLIResponse& response)
+  {
+    const std::string_view body = collectResponseBody(response);
+
+    char header[1 + BinaryFrameDecoder::MAX_VARINT_LENGTH];
+    header[0] = static_cast<char>(response.getStatus());
+    const size_t headerLength = 1 + BinaryFrameDecoder::encodeVarint(static_cast<uint32_t>(body.length()), header + 1);
+
+    writeOutput(std::string_view(header, headerLength));
+    writeOutput(body);
+    flushOutput();
+
+    _frameBuffer.clear();
+  }
+
+
+  std::string_view CLIService::collectResponseBody(const CLIResponse& response)
+  {
+    const auto& source = response.getOutputSource();
+    if (!source) { return response.getMessage(); }
+
+    // The length goes first, so streamed lines are gathered up front
+    const std::string_view newLine = _messages.getNewLine();
+    _frameBuffer = response.getMessage();
+
+    // Lines split as MessageLineSource does: a trailing line break does not
+    // start another line, an empty message is no line at all
+    bool lineWritten = !_frameBuffer.empty();
+
+    if (_frameBuffer.length() >= newLine.length() &&
+        _frameBuffer.compare(_frameBuffer.length() - newLine.length(), newLine.length(), newLine) == 0)
+    {
+      _frameBuffer.resize(_frameBuffer.length() - newLine.length());
+    }
+
+    while (source->nextLine(_lineBuffer))
+    {
+      if (lineWritten) { _frameBuffer += newLine; }
+      _frameBuffer += _lineBuffer;
+      lineWritten = true;
+    }
+
+    return _frameBuffer;
+  }
+
+
+  void CLIService::writeOutput(std::string_view text)
+  {
+    if (_outputBuffer.length() + text.length() > OUTPUT_BUFFER_CAPACITY)
+    {
+      flushOutput();
+
+      // Too long to be buffered at all
+      if (text.length() > OUTPUT_BUFFER_CAPACITY)
+      {
+        _txScheduler.write(text, TxPriority::Bulk);
+        return;
+      }
+    }
+
+    _outputBuffer += text;
+  }
+
+
+  void CLIService::flushOutput()
+  {
+    if (_outputBuffer.empty()) { return; }
 
-    return substrings;
+    _txScheduler.write(_outputBuffer, TxPriority::Bulk);
+    _outputBuffer.clear();
   }
 
 }
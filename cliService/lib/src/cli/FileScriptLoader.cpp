@@ -0,0 +1,52 @@
+#include "cliService/cli/FileScriptLoader.hpp"
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+namespace cliService
+{
+
+  FileScriptLoader::FileScriptLoader(std::string baseDirectory)
+    : _baseDirectory(std::move(baseDirectory))
+  {
+  }
+
+
+  bool FileScriptLoader::load(std::string_view name, std::string& content)
+  {
+    if (!isConfined(name)) { return false; }
+
+    std::string path = _baseDirectory;
+    if (!path.empty() && path.back() != '/') { path += '/'; }
+    path += name;
+
+    std::ifstream file{path, std::ios::binary};
+    if (!file) { return false; }
+
+    std::ostringstream stream;
+    stream << file.rdbuf();
+    content = stream.str();
+    return true;
+  }
+
+
+  bool FileScriptLoader::isConfined(std::string_view name)
+  {
+    // Backslashes and drive letters would escape on Windows
+    if (name.empty() || name.front() == '/' || name.find_first_of("\\:") != std::string_view::npos) {
+      return false;
+    }
+
+    for (size_t pos = 0; pos <= name.length();)
+    {
+      size_t end = name.find('/', pos);
+      if (end == std::string_view::npos) { end = name.length(); }
+
+      if (name.substr(pos, end - pos) == "..") { return false; }
+      pos = end + 1;
+    }
+
+    return true;
+  }
+
+}
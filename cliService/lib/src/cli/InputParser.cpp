@@ -11,7 +11,9 @@ namespace cliService
     , _inEscapeSequence(false)
     , _escapeBuffer(MAX_ESCAPE_LENGTH)
     , _escapeIndex(0)
-  {}
+  {
+    _buffer.reserve(LINE_BUFFER_CAPACITY);
+  }
 
 
   std::optional<std::unique_ptr<RequestBase>> InputParser::getNextRequest()
@@ -27,6 +29,22 @@ namespace cliService
   }
 
 
+  void InputParser::setTracer(TracerIf* tracer, const ClockIf& clock)
+  {
+    _tracer = tracer;
+    _tracerClock = &clock;
+  }
+
+
+#if CLISERVICE_LATENCY_STATS
+  void InputParser::setLatencyProbe(const ClockIf& clock, LatencyStats& stats)
+  {
+    _latencyClock = &clock;
+    _latencyStats = &stats;
+  }
+#endif
+
+
   void InputParser::replaceBuffer(const std::string& newContent, bool display)
   {
     if (display)
@@ -71,7 +89,8 @@ namespace cliService
   std::unique_ptr<CommandRequest> InputParser::parseToCommandRequest(std::string_view input)
   {
     ParsedPathAndArgs parsedPath = parseToPathAndArgs(input);
-    return std::make_unique<CommandRequest>(parsedPath.path, std::move(parsedPath.args), input);
+    return std::make_unique<CommandRequest>(parsedPath.path, std::move(parsedPath.args), input,
+                                            std::move(parsedPath.filters), parsedPath.background);
   }
 
 
@@ -113,6 +132,22 @@ namespace cliService
       return false;
     }
 
+#if CLISERVICE_LATENCY_STATS
+    // Escape sequences are timed from their first byte
+    if (_latencyClock && !_inEscapeSequence) {
+      _receivedAt_us = _latencyClock->now_us();
+    }
+#endif
+
+    // Terminals sending CR LF for Enter must not page twice, nor page on
+    // the line feed left over from the line that started the output
+    const bool lineFeedOfCrLf = (c == ENTER_LF && _previousChar == ENTER_CR);
+    _previousChar = c;
+
+    if (_pagerMode) {
+      return !lineFeedOfCrLf && handlePagerKey(c);
+    }
+
     if (_inEscapeSequence)
     {
       // Protect against buffer overflow
@@ -155,7 +190,10 @@ namespace cliService
     {
       if (!_buffer.empty())
       {
-        _ioStream.putString("\r\n");  // Echo newline
+        if (!_machineMode) {
+          _ioStream.putString("\r\n");  // Echo newline
+        }
+
         _trigger = ActionTrigger::Enter;
         return true;
       }
@@ -179,6 +217,30 @@ namespace cliService
   }
 
 
+  bool InputParser::handlePagerKey(char c)
+  {
+    switch (c)
+    {
+      case ' ':
+        _pagerAction = PagerRequest::Action::NextPage;
+        return true;
+
+      case ENTER_CR:
+      case ENTER_LF:
+        _pagerAction = PagerRequest::Action::NextLine;
+        return true;
+
+      case 'q':
+      case 'Q':
+        _pagerAction = PagerRequest::Action::Quit;
+        return true;
+
+      default:
+        return false;  // Everything else is ignored while paging
+    }
+  }
+
+
   bool InputParser::handleControlCharacter(char c)
   {
     switch (c)
@@ -188,12 +250,15 @@ namespace cliService
         if (!_buffer.empty())
         {
           _buffer.pop_back();
-          _ioStream.putString("\b \b");
+
+          if (!_machineMode) {
+            _ioStream.putString("\b \b");
+          }
         }
         break;
 
       case TAB:
-        if (_currentCLIState == CLIState::LoggedIn)
+        if (_currentCLIState == CLIState::LoggedIn && !_machineMode)
         {
           _trigger = ActionTrigger::Tab;
           return true;
@@ -212,8 +277,8 @@ namespace cliService
   {
     _inEscapeSequence = false;
 
-    // Basic safety check
-    if (_escapeIndex < 2) {
+    // Basic safety check, no history navigation in machine mode
+    if (_escapeIndex < 2 || _machineMode) {
         return false;
     }
 
@@ -252,11 +317,19 @@ namespace cliService
   {
     _buffer += c;
     echoCharacter(c);
+
+#if CLISERVICE_LATENCY_STATS
+    if (_latencyStats) {
+      _latencyStats->record(LatencyStats::Kind::CharEcho, _latencyClock->now_us() - _receivedAt_us);
+    }
+#endif
   }
 
 
   void InputParser::echoCharacter(char c)
   {
+    if (_machineMode) { return; }
+
     if (_currentCLIState == CLIState::LoggedOut)
     {
       size_t colonPos = _buffer.find(':');
@@ -285,6 +358,12 @@ namespace cliService
 
   std::optional<std::unique_ptr<RequestBase>> InputParser::createRequest()
   {
+    TraceScope trace(_tracer, _tracerClock, TracePhase::Parse);
+
+    if (_pagerMode) {
+      return std::make_unique<PagerRequest>(_pagerAction);
+    }
+
     switch (_currentCLIState)
     {
       case CLIState::LoggedOut:
@@ -340,6 +419,49 @@ namespace cliService
   {
     Path path;
     std::vector<std::string> args;
+    CommandRequest::Filters filters;
+    bool background = false;
+
+    // A trailing '&' runs the whole line as a background job
+    while (!input.empty() && input.back() == ' ') {
+      input.remove_suffix(1);
+    }
+
+    if (!input.empty() && input.back() == '&')
+    {
+      background = true;
+      input.remove_suffix(1);
+    }
+
+    // Everything after the first '|' are filter stages, one per '|'
+    const size_t pipePos = input.find('|');
+
+    if (pipePos != std::string_view::npos)
+    {
+      std::string_view stages = input.substr(pipePos + 1);
+      input = input.substr(0, pipePos);
+
+      while (true)
+      {
+        const size_t end = stages.find('|');
+        std::istringstream stageStream{std::string(stages.substr(0, end))};
+        std::string word;
+
+        auto& stage = filters.emplace_back();
+
+        while (stageStream >> word) {
+          stage.push_back(std::move(word));
+        }
+
+        if (end == std::string_view::npos) { break; }
+        stages.remove_prefix(end + 1);
+      }
+
+      // Spaces before the '|' belong to neither side
+      while (!input.empty() && input.back() == ' ') {
+        input.remove_suffix(1);
+      }
+    }
 
     // Split input into path and args
     std::string_view pathStr, argsStr;
@@ -391,7 +513,7 @@ namespace cliService
       }
     }
 
-    return ParsedPathAndArgs{std::move(path), std::move(args)};
+    return ParsedPathAndArgs{std::move(path), std::move(args), std::move(filters), background};
   }
 
 }
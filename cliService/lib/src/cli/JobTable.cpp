@@ -0,0 +1,177 @@
+#include "cliService/cli/JobTable.hpp"
+#include <algorithm>
+
+namespace cliService
+{
+
+  // Buffered lines of a job, then the rest of its output
+  class JobOutputSource : public OutputSourceIf
+  {
+  public:
+    JobOutputSource(std::deque<std::string> lines, size_t droppedLines, std::shared_ptr<OutputSourceIf> rest)
+      : _lines(std::move(lines))
+      , _droppedLines(droppedLines)
+      , _rest(std::move(rest))
+    {}
+
+    bool nextLine(std::string& line) override
+    {
+      if (_droppedLines > 0)
+      {
+        line = "(" + std::to_string(_droppedLines) + " earlier lines dropped)";
+        _droppedLines = 0;
+        return true;
+      }
+
+      if (!_lines.empty())
+      {
+        line.swap(_lines.front());
+        _lines.pop_front();
+        return true;
+      }
+
+      return _rest && _rest->nextLine(line);
+    }
+
+  private:
+    std::deque<std::string> _lines;
+    size_t _droppedLines;
+    std::shared_ptr<OutputSourceIf> _rest;
+  };
+
+
+  BackgroundJob::BackgroundJob(uint32_t id, std::string commandLine, CLIResponse::Status status,
+                               std::shared_ptr<OutputSourceIf> source, size_t capacity)
+    : _id(id)
+    , _commandLine(std::move(commandLine))
+    , _status(status)
+    , _source(std::move(source))
+    , _capacity(capacity)
+  {}
+
+
+  BackgroundJob::BackgroundJob(uint32_t id, std::string commandLine, JobStart start, size_t capacity)
+    : _id(id)
+    , _commandLine(std::move(commandLine))
+    , _status(CLIResponse::Status::Success)
+    , _start(std::move(start))
+    , _capacity(capacity)
+  {}
+
+
+  bool BackgroundJob::pull(size_t maxLines)
+  {
+    if (_start) { begin(); }
+
+    std::string line;
+
+    for (size_t i = 0; i < maxLines && _source; ++i)
+    {
+      if (!_source->nextLine(line))
+      {
+        _source.reset();
+        break;
+      }
+
+      store(line);
+    }
+
+    return isRunning();
+  }
+
+
+  void BackgroundJob::begin()
+  {
+    JobStart start = std::move(_start);
+    _start = nullptr;
+    _source = start(_status);
+  }
+
+
+  void BackgroundJob::store(std::string& line)
+  {
+    // A single line larger than the whole buffer is cut down to it
+    const size_t maxLength = _capacity > LINE_OVERHEAD ? _capacity - LINE_OVERHEAD : 0;
+
+    if (line.length() > maxLength) {
+      line.resize(maxLength);
+    }
+
+    const size_t cost = line.length() + LINE_OVERHEAD;
+
+    while (!_lines.empty() && (_bufferedBytes + cost > _capacity || _lines.size() >= MAX_LINES))
+    {
+      _bufferedBytes -= _lines.front().length() + LINE_OVERHEAD;
+      _lines.pop_front();
+      _droppedLines++;
+    }
+
+    _bufferedBytes += cost;
+    _lines.push_back(std::move(line));
+  }
+
+
+  std::shared_ptr<OutputSourceIf> BackgroundJob::takeOutput()
+  {
+    if (_start) { begin(); }
+
+    auto output = std::make_shared<JobOutputSource>(std::move(_lines), _droppedLines, std::move(_source));
+
+    _lines.clear();
+    _source.reset();
+    _bufferedBytes = 0;
+    _droppedLines = 0;
+
+    return output;
+  }
+
+
+  BackgroundJob* JobTable::start(std::string commandLine, CLIResponse::Status status, std::shared_ptr<OutputSourceIf> source)
+  {
+    if (_jobs.size() >= MAX_JOBS) { return nullptr; }
+
+    const uint32_t id = _jobs.empty() ? 1 : _jobs.back().getId() + 1;
+    return &_jobs.emplace_back(id, std::move(commandLine), status, std::move(source), _outputCapacity);
+  }
+
+
+  BackgroundJob* JobTable::start(std::string commandLine, JobStart start)
+  {
+    if (_jobs.size() >= MAX_JOBS) { return nullptr; }
+
+    const uint32_t id = _jobs.empty() ? 1 : _jobs.back().getId() + 1;
+    return &_jobs.emplace_back(id, std::move(commandLine), std::move(start), _outputCapacity);
+  }
+
+
+  void JobTable::service(size_t maxLines)
+  {
+    for (auto& job : _jobs)
+    {
+      if (job.isRunning()) {
+        job.pull(maxLines);
+      }
+    }
+  }
+
+
+  BackgroundJob* JobTable::find(uint32_t id)
+  {
+    auto it = std::find_if(_jobs.begin(), _jobs.end(), [id](const BackgroundJob& job) { return job.getId() == id; });
+    return it != _jobs.end() ? &*it : nullptr;
+  }
+
+
+  void JobTable::remove(uint32_t id)
+  {
+    _jobs.erase(std::remove_if(_jobs.begin(), _jobs.end(), [id](const BackgroundJob& job) { return job.getId() == id; }),
+                _jobs.end());
+  }
+
+
+  bool JobTable::isRunning() const
+  {
+    return std::any_of(_jobs.begin(), _jobs.end(), [](const BackgroundJob& job) { return job.isRunning(); });
+  }
+
+}
@@ -0,0 +1,88 @@
+#include "cliService/cli/LoginThrottle.hpp"
+#include <algorithm>
+
+namespace cliService
+{
+
+  LoginThrottle::LoginThrottle(uint64_t baseDelay_ms, uint64_t maxDelay_ms)
+    : _baseDelay_us(baseDelay_ms * 1000)
+    , _maxDelay_us(std::max(baseDelay_ms, maxDelay_ms) * 1000)
+  {
+  }
+
+
+  uint64_t LoginThrottle::recordFailure(Backoff& backoff, uint64_t now_us) const
+  {
+    if (backoff.failures > 0 && now_us - backoff.lastFailure_us >= FORGET_AFTER_US) {
+      backoff.failures = 0;
+    }
+
+    if (backoff.failures < UINT32_MAX) { backoff.failures++; }
+    backoff.lastFailure_us = now_us;
+
+    const uint64_t delay_us = getDelay_us(backoff.failures);
+    backoff.deadline_us = now_us + delay_us;
+    return delay_us;
+  }
+
+
+  uint64_t LoginThrottle::recordFailure(const std::string& username, uint64_t now_us)
+  {
+    auto it = _usernames.find(username);
+
+    if (it == _usernames.end())
+    {
+      if (_usernames.size() >= MAX_TRACKED_USERNAMES)
+      {
+        // A name still waiting is never evicted, flooding with fresh names
+        // must not lift its wait
+        auto oldest = _usernames.end();
+
+        for (auto candidate = _usernames.begin(); candidate != _usernames.end(); ++candidate)
+        {
+          if (candidate->second.isWaiting(now_us)) { continue; }
+
+          if (oldest == _usernames.end() || candidate->second.lastFailure_us < oldest->second.lastFailure_us) {
+            oldest = candidate;
+          }
+        }
+
+        // All waiting, the new name goes untracked and only the session backs off
+        if (oldest == _usernames.end()) { return 0; }
+
+        _usernames.erase(oldest);
+      }
+
+      it = _usernames.emplace(username, Backoff()).first;
+    }
+
+    return recordFailure(it->second, now_us);
+  }
+
+
+  bool LoginThrottle::isWaiting(const std::string& username, uint64_t now_us) const
+  {
+    auto it = _usernames.find(username);
+    return it != _usernames.end() && it->second.isWaiting(now_us);
+  }
+
+
+  uint64_t LoginThrottle::getDeadline_us(const std::string& username) const
+  {
+    auto it = _usernames.find(username);
+    return it != _usernames.end() ? it->second.deadline_us : 0;
+  }
+
+
+  uint64_t LoginThrottle::getDelay_us(uint32_t failures) const
+  {
+    if (failures <= FREE_FAILURES || _baseDelay_us == 0) { return 0; }
+
+    // Doubling beyond the cap would only overflow
+    const uint32_t doublings = failures - FREE_FAILURES - 1;
+    if (doublings >= 32) { return _maxDelay_us; }
+
+    return std::min(_baseDelay_us << doublings, _maxDelay_us);
+  }
+
+}
@@ -0,0 +1,96 @@
+#include "cliService/cli/RingBufferTracer.hpp"
+#include <cassert>
+
+namespace cliService
+{
+
+  RingBufferTracer::RingBufferTracer(size_t capacity)
+    : _events(capacity)
+  {
+    assert(capacity > 0 && "Tracer capacity must be positive");
+  }
+
+
+  void RingBufferTracer::record(TracePhase phase, uint64_t begin_us, uint64_t end_us, std::string_view detail)
+  {
+    _events[_next] = Event{phase, begin_us, end_us, detail};
+    _next = (_next + 1) % _events.size();
+
+    if (_count < _events.size()) {
+      _count++;
+    }
+    else {
+      _dropped++;
+    }
+  }
+
+
+  std::vector<RingBufferTracer::Event> RingBufferTracer::getEvents() const
+  {
+    std::vector<Event> events;
+    events.reserve(_count);
+
+    const size_t first = (_next + _events.size() - _count) % _events.size();
+
+    for (size_t i = 0; i < _count; ++i) {
+      events.push_back(_events[(first + i) % _events.size()]);
+    }
+
+    return events;
+  }
+
+
+  std::string RingBufferTracer::toChromeTraceJson() const
+  {
+    auto escape = [](std::string_view text) {
+      std::string escaped;
+
+      for (char c : text)
+      {
+        if (c == '"' || c == '\\') {
+          escaped += '\\';
+        }
+
+        if (static_cast<unsigned char>(c) < 0x20) {
+          continue;  // Control characters never appear in node names
+        }
+
+        escaped += c;
+      }
+
+      return escaped;
+    };
+
+    std::string json = "{\"traceEvents\":[";
+    bool first = true;
+
+    for (const auto& event : getEvents())
+    {
+      if (!first) { json += ","; }
+      first = false;
+
+      json += "{\"name\":\"" + std::string(getTracePhaseName(event.phase)) + "\"";
+      json += ",\"cat\":\"cliService\",\"ph\":\"X\",\"pid\":1,\"tid\":1";
+      json += ",\"ts\":" + std::to_string(event.begin_us);
+      json += ",\"dur\":" + std::to_string(event.end_us - event.begin_us);
+
+      if (!event.detail.empty()) {
+        json += ",\"args\":{\"node\":\"" + escape(event.detail) + "\"}";
+      }
+
+      json += "}";
+    }
+
+    json += "]}";
+    return json;
+  }
+
+
+  void RingBufferTracer::clear()
+  {
+    _next = 0;
+    _count = 0;
+    _dropped = 0;
+  }
+
+}
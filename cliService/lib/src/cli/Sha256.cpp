@@ -0,0 +1,257 @@
+#include "cliService/cli/Sha256.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace cliService
+{
+
+  static constexpr std::array<uint32_t, 64> ROUND_CONSTANTS = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+  };
+
+
+  static inline uint32_t rotateRight(uint32_t value, unsigned bits)
+  {
+    return (value >> bits) | (value << (32 - bits));
+  }
+
+
+  void Sha256::reset()
+  {
+    _state = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+    _blockLength = 0;
+    _totalLength = 0;
+  }
+
+
+  void Sha256::update(const uint8_t* data, size_t length)
+  {
+    _totalLength += length;
+
+    while (length > 0)
+    {
+      // Whole blocks are compressed straight from the input
+      if (_blockLength == 0 && length >= BLOCK_SIZE)
+      {
+        compress(data);
+        data += BLOCK_SIZE;
+        length -= BLOCK_SIZE;
+        continue;
+      }
+
+      const size_t count = std::min(length, BLOCK_SIZE - _blockLength);
+      std::memcpy(_block.data() + _blockLength, data, count);
+      _blockLength += count;
+      data += count;
+      length -= count;
+
+      if (_blockLength == BLOCK_SIZE)
+      {
+        compress(_block.data());
+        _blockLength = 0;
+      }
+    }
+  }
+
+
+  Sha256::Digest Sha256::finish()
+  {
+    const uint64_t bitLength = _totalLength * 8;
+
+    // A single 1 bit, zeros up to 8 bytes before the block end, then the length
+    _block[_blockLength++] = 0x80;
+
+    if (_blockLength > BLOCK_SIZE - 8)
+    {
+      std::fill(_block.begin() + _blockLength, _block.end(), 0);
+      compress(_block.data());
+      _blockLength = 0;
+    }
+
+    std::fill(_block.begin() + _blockLength, _block.end() - 8, 0);
+
+    for (size_t i = 0; i < 8; ++i) {
+      _block[BLOCK_SIZE - 1 - i] = static_cast<uint8_t>(bitLength >> (8 * i));
+    }
+
+    compress(_block.data());
+
+    Digest digest;
+
+    for (size_t i = 0; i < _state.size(); ++i)
+    {
+      digest[4 * i] = static_cast<uint8_t>(_state[i] >> 24);
+      digest[4 * i + 1] = static_cast<uint8_t>(_state[i] >> 16);
+      digest[4 * i + 2] = static_cast<uint8_t>(_state[i] >> 8);
+      digest[4 * i + 3] = static_cast<uint8_t>(_state[i]);
+    }
+
+    reset();
+    return digest;
+  }
+
+
+  Sha256::Digest Sha256::hash(std::string_view data)
+  {
+    Sha256 sha;
+    sha.update(data);
+    return sha.finish();
+  }
+
+
+  void Sha256::compress(const uint8_t* block)
+  {
+    uint32_t w[64];
+
+    for (size_t i = 0; i < 16; ++i)
+    {
+      w[i] = (static_cast<uint32_t>(block[4 * i]) << 24) | (static_cast<uint32_t>(block[4 * i + 1]) << 16) |
+             (static_cast<uint32_t>(block[4 * i + 2]) << 8) | static_cast<uint32_t>(block[4 * i + 3]);
+    }
+
+    for (size_t i = 16; i < 64; ++i)
+    {
+      const uint32_t s0 = rotateRight(w[i - 15], 7) ^ rotateRight(w[i - 15], 18) ^ (w[i - 15] >> 3);
+      const uint32_t s1 = rotateRight(w[i - 2], 17) ^ rotateRight(w[i - 2], 19) ^ (w[i - 2] >> 10);
+      w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    uint32_t a = _state[0], b = _state[1], c = _state[2], d = _state[3];
+    uint32_t e = _state[4], f = _state[5], g = _state[6], h = _state[7];
+
+    for (size_t i = 0; i < 64; ++i)
+    {
+      const uint32_t s1 = rotateRight(e, 6) ^ rotateRight(e, 11) ^ rotateRight(e, 25);
+      const uint32_t choice = (e & f) ^ (~e & g);
+      const uint32_t temp1 = h + s1 + choice + ROUND_CONSTANTS[i] + w[i];
+      const uint32_t s0 = rotateRight(a, 2) ^ rotateRight(a, 13) ^ rotateRight(a, 22);
+      const uint32_t majority = (a & b) ^ (a & c) ^ (b & c);
+      const uint32_t temp2 = s0 + majority;
+
+      h = g;
+      g = f;
+      f = e;
+      e = d + temp1;
+      d = c;
+      c = b;
+      b = a;
+      a = temp1 + temp2;
+    }
+
+    _state[0] += a;
+    _state[1] += b;
+    _state[2] += c;
+    _state[3] += d;
+    _state[4] += e;
+    _state[5] += f;
+    _state[6] += g;
+    _state[7] += h;
+  }
+
+
+  // Inner and outer hash states with the padded key already absorbed
+  struct HmacKey
+  {
+    Sha256 inner;
+    Sha256 outer;
+
+    explicit HmacKey(std::string_view key)
+    {
+      std::array<uint8_t, Sha256::BLOCK_SIZE> padded{};
+
+      if (key.length() > Sha256::BLOCK_SIZE)
+      {
+        const auto digest = Sha256::hash(key);
+        std::copy(digest.begin(), digest.end(), padded.begin());
+      }
+      else {
+        std::copy(key.begin(), key.end(), padded.begin());
+      }
+
+      std::array<uint8_t, Sha256::BLOCK_SIZE> pad;
+
+      for (size_t i = 0; i < pad.size(); ++i) { pad[i] = padded[i] ^ 0x36; }
+      inner.update(pad.data(), pad.size());
+
+      for (size_t i = 0; i < pad.size(); ++i) { pad[i] = padded[i] ^ 0x5c; }
+      outer.update(pad.data(), pad.size());
+    }
+
+    // HMAC of the message fed to 'messageState', a copy of 'inner'
+    Sha256::Digest finish(Sha256& messageState) const
+    {
+      const auto innerDigest = messageState.finish();
+      Sha256 outerState = outer;
+      outerState.update(innerDigest.data(), innerDigest.size());
+      return outerState.finish();
+    }
+  };
+
+
+  Sha256::Digest hmacSha256(std::string_view key, std::string_view message)
+  {
+    const HmacKey hmacKey(key);
+    Sha256 state = hmacKey.inner;
+    state.update(message);
+    return hmacKey.finish(state);
+  }
+
+
+  void pbkdf2Sha256(std::string_view password, std::string_view salt, uint32_t iterations, uint8_t* out, size_t length)
+  {
+    const HmacKey hmacKey(password);
+
+    for (uint32_t blockIndex = 1; length > 0; ++blockIndex)
+    {
+      // U1 = HMAC(password, salt || INT(blockIndex))
+      const uint8_t indexBytes[4] = {
+        static_cast<uint8_t>(blockIndex >> 24), static_cast<uint8_t>(blockIndex >> 16),
+        static_cast<uint8_t>(blockIndex >> 8), static_cast<uint8_t>(blockIndex)
+      };
+
+      Sha256 state = hmacKey.inner;
+      state.update(salt);
+      state.update(indexBytes, sizeof(indexBytes));
+
+      Sha256::Digest u = hmacKey.finish(state);
+      Sha256::Digest block = u;
+
+      // Un = HMAC(password, Un-1), all XORed together
+      for (uint32_t i = 1; i < iterations; ++i)
+      {
+        state = hmacKey.inner;
+        state.update(u.data(), u.size());
+        u = hmacKey.finish(state);
+
+        for (size_t j = 0; j < block.size(); ++j) {
+          block[j] ^= u[j];
+        }
+      }
+
+      const size_t count = std::min(length, block.size());
+      std::copy(block.begin(), block.begin() + count, out);
+      out += count;
+      length -= count;
+    }
+  }
+
+
+  bool constantTimeEquals(const uint8_t* a, const uint8_t* b, size_t length)
+  {
+    uint8_t difference = 0;
+
+    for (size_t i = 0; i < length; ++i) {
+      difference |= a[i] ^ b[i];
+    }
+
+    return difference == 0;
+  }
+
+}
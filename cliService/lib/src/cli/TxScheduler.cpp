@@ -0,0 +1,167 @@
+#include "cliService/cli/TxScheduler.hpp"
+#include <algorithm>
+#include <cassert>
+
+namespace cliService
+{
+
+  TxScheduler::TxScheduler(CharIOStreamIf& ioStream, const ClockIf& clock, uint32_t bytesPerSecond, size_t bulkCapacity)
+    : _ioStream(ioStream)
+    , _clock(clock)
+    , _bytesPerSecond(bytesPerSecond)
+    , _lastPump_us(clock.now_us())
+  {
+    if (!isPaced()) { return; }
+
+    assert(bulkCapacity > 0 && "Bulk queue capacity must be positive");
+    _interactive.data.resize(INTERACTIVE_CAPACITY);
+    _bulk.data.resize(bulkCapacity);
+  }
+
+
+  void TxScheduler::write(std::string_view text, TxPriority priority)
+  {
+    if (!isPaced())
+    {
+      if (text.length() == 1) {
+        _ioStream.putChar(text.front());
+      }
+      else {
+        _ioStream.putString(text);
+      }
+
+      _sent += text.length();
+      return;
+    }
+
+    if (priority == TxPriority::Interactive)
+    {
+      // Keystrokes must never be lost, the link copes with a short burst
+      if (_interactive.count + text.length() > _interactive.data.size())
+      {
+        if (isFenced()) {
+          send(_interactive, _unfencedBytes);
+          send(_bulk, static_cast<size_t>(_fenceAt - _bulk.popped));
+        }
+
+        send(_interactive, _interactive.count);
+        _ioStream.putString(text);
+        _sent += text.length();
+        return;
+      }
+
+      push(_interactive, text);
+      return;
+    }
+
+    while (!text.empty())
+    {
+      if (_bulk.count == _bulk.data.size()) {
+        send(_bulk, std::min(_bulk.count, text.length()));
+      }
+
+      const size_t chunk = std::min(text.length(), _bulk.data.size() - _bulk.count);
+      push(_bulk, text.substr(0, chunk));
+      text.remove_prefix(chunk);
+    }
+  }
+
+
+  void TxScheduler::pump()
+  {
+    if (!isPaced()) { return; }
+
+    const uint64_t now = _clock.now_us();
+    const uint64_t elapsed = std::min<uint64_t>(now - _lastPump_us, MAX_BURST_US);
+    _lastPump_us = now;
+
+    if (isIdle())
+    {
+      // Idle time does not add up to one big burst later
+      _credit = 0;
+      return;
+    }
+
+    _credit = std::min<uint64_t>(_credit + elapsed * _bytesPerSecond, MAX_BURST_US * _bytesPerSecond);
+    size_t budget = static_cast<size_t>(_credit / 1000000);
+
+    size_t sent = sendInteractive(budget);
+    sent += send(_bulk, budget - sent);
+
+    // Keys held by a fence follow once the bulk bytes before it are out
+    sent += sendInteractive(budget - sent);
+
+    _credit -= static_cast<uint64_t>(sent) * 1000000;
+  }
+
+
+  void TxScheduler::fence()
+  {
+    if (!isPaced() || _bulk.count == 0) { return; }
+
+    // An earlier fence not reached yet still holds its bytes
+    if (!isFenced()) {
+      _unfencedBytes = _interactive.count;
+    }
+
+    _fenceAt = _bulk.pushed;
+  }
+
+
+  size_t TxScheduler::sendInteractive(size_t maxBytes)
+  {
+    if (!isFenced()) {
+      return send(_interactive, maxBytes);
+    }
+
+    const size_t sent = send(_interactive, std::min(maxBytes, _unfencedBytes));
+    _unfencedBytes -= sent;
+    return sent;
+  }
+
+
+  size_t TxScheduler::getFreeSpace(TxPriority priority) const
+  {
+    if (!isPaced()) { return UNLIMITED_SPACE; }
+
+    const Queue& q = queue(priority);
+    return q.data.size() - q.count;
+  }
+
+
+  void TxScheduler::push(Queue& queue, std::string_view text)
+  {
+    assert(queue.count + text.length() <= queue.data.size() && "Queue overflow");
+
+    for (char c : text) {
+      queue.data[(queue.head + queue.count++) % queue.data.size()] = c;
+    }
+
+    queue.pushed += text.length();
+
+    queue.peak = std::max(queue.peak, queue.count);
+  }
+
+
+  size_t TxScheduler::send(Queue& queue, size_t maxBytes)
+  {
+    const size_t total = std::min(maxBytes, queue.count);
+    size_t remaining = total;
+
+    // At most two contiguous runs, before and after the wrap around
+    while (remaining > 0)
+    {
+      const size_t run = std::min(remaining, queue.data.size() - queue.head);
+      _ioStream.putString(std::string_view(queue.data.data() + queue.head, run));
+
+      queue.head = (queue.head + run) % queue.data.size();
+      queue.count -= run;
+      remaining -= run;
+    }
+
+    queue.popped += total;
+    _sent += total;
+    return total;
+  }
+
+}
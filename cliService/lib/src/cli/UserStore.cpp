@@ -0,0 +1,84 @@
+#include "cliService/cli/UserStore.hpp"
+
+namespace cliService
+{
+
+  UserStore::UserStore(uint32_t iterations, uint64_t seed)
+    : _iterations(iterations > 0 ? iterations : 1)
+    , _saltState{seed, 0}
+    , _dummy{User("", "", AccessLevel()), {}, {}, 0}
+  {
+    setDummy(_iterations);
+  }
+
+
+  bool UserStore::addUser(const User& user)
+  {
+    if (contains(user.getUsername())) { return false; }
+
+    const Salt salt = generateSalt();
+    return addHashedUser(user.getUsername(), user.getAccessLevel(), salt, hashPassword(user.getPassword(), salt, _iterations), _iterations);
+  }
+
+
+  bool UserStore::addHashedUser(const std::string& username, AccessLevel level, const Salt& salt, const Hash& hash, uint32_t iterations)
+  {
+    if (!_users.emplace(username, Account{User(username, "", level), salt, hash, iterations}).second) { return false; }
+
+    if (iterations > _dummy.iterations) {
+      setDummy(iterations);
+    }
+
+    return true;
+  }
+
+
+  const User* UserStore::authenticate(const std::string& username, const std::string& password) const
+  {
+    auto it = _users.find(username);
+    const Account& account = it != _users.end() ? it->second : _dummy;
+
+    const Hash hash = hashPassword(password, account.salt, account.iterations);
+    bool match = constantTimeEquals(hash.data(), account.hash.data(), HASH_SIZE);
+
+    // Accounts with a smaller work factor make up the difference. The padding
+    // never matches the dummy, comparing it only keeps the work from being
+    // optimized away.
+    if (account.iterations < _dummy.iterations)
+    {
+      const Hash padding = hashPassword(password, _dummy.salt, _dummy.iterations - account.iterations);
+      match &= !constantTimeEquals(padding.data(), _dummy.hash.data(), HASH_SIZE);
+    }
+
+    return (match && it != _users.end()) ? &account.user : nullptr;
+  }
+
+
+  UserStore::Hash UserStore::hashPassword(const std::string& password, const Salt& salt, uint32_t iterations)
+  {
+    Hash hash;
+    pbkdf2Sha256(password, std::string_view(reinterpret_cast<const char*>(salt.data()), salt.size()), iterations, hash.data(), hash.size());
+    return hash;
+  }
+
+
+  UserStore::Salt UserStore::generateSalt()
+  {
+    _saltState[1]++;
+
+    const auto digest = Sha256::hash(std::string_view(reinterpret_cast<const char*>(_saltState.data()), sizeof(_saltState)));
+
+    Salt salt;
+    std::copy(digest.begin(), digest.begin() + SALT_SIZE, salt.begin());
+    return salt;
+  }
+
+
+  void UserStore::setDummy(uint32_t iterations)
+  {
+    _dummy.iterations = iterations;
+    _dummy.salt = generateSalt();
+    _dummy.hash = hashPassword("", _dummy.salt, iterations);
+  }
+
+}
@@ -0,0 +1,84 @@
+#include "cliService/cli/WatchView.hpp"
+#include <algorithm>
+
+namespace cliService
+{
+
+  static constexpr const char* ERASE_TO_END_OF_LINE = "\033[K";
+
+
+  void WatchView::update(const std::vector<std::string>& lines, std::string& out)
+  {
+    for (size_t i = 0; i < lines.size(); ++i) {
+      updateLine(i, lines[i], out);
+    }
+
+    // Lines the new output no longer has
+    for (size_t i = lines.size(); i < _lines.size(); ++i)
+    {
+      moveCursor(_firstRow + i, 1, out);
+      out += ERASE_TO_END_OF_LINE;
+    }
+
+    _lines.resize(lines.size());
+  }
+
+
+  void WatchView::moveBelow(std::string& out) const
+  {
+    moveCursor(_firstRow + _lines.size(), 1, out);
+  }
+
+
+  void WatchView::moveCursor(size_t row, size_t column, std::string& out)
+  {
+    out += "\033[";
+    out += std::to_string(row);
+    out += ';';
+    out += std::to_string(column);
+    out += 'H';
+  }
+
+
+  void WatchView::updateLine(size_t index, const std::string& line, std::string& out)
+  {
+    if (index == _lines.size()) {
+      _lines.emplace_back();
+    }
+
+    std::string& shown = _lines[index];
+    if (shown == line) { return; }
+
+    const size_t common = std::min(shown.length(), line.length());
+    size_t first = 0;
+
+    while (first < common && shown[first] == line[first]) {
+      first++;
+    }
+
+    moveCursor(_firstRow + index, first + 1, out);
+
+    if (shown.length() == line.length())
+    {
+      // Same length, the unchanged tail stays on screen
+      size_t last = line.length() - 1;
+
+      while (last > first && shown[last] == line[last]) {
+        last--;
+      }
+
+      out.append(line, first, last - first + 1);
+    }
+    else
+    {
+      out.append(line, first, std::string::npos);
+
+      if (line.length() < shown.length()) {
+        out += ERASE_TO_END_OF_LINE;
+      }
+    }
+
+    shown = line;
+  }
+
+}
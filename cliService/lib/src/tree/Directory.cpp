@@ -7,7 +7,12 @@ namespace cliService
 
   Directory::Directory(std::string name, AccessLevel level)
     : NodeIf(std::move(name), level)
-  {}
+  {
+    _id = ROOT_ID;  // Until added to another directory
+  }
+
+
+  Directory::~Directory() = default;
 
 
   NodeIf* Directory::findNode(const std::vector<std::string>& path) const
@@ -32,34 +37,135 @@ namespace cliService
   }
 
 
-  void Directory::traverse(const std::function<void(const NodeIf&, size_t)>& visitor, size_t depth) const
+  void Directory::traverse(const std::function<void(const NodeIf&, size_t)>& visitor, size_t depth) const {
+    visit(visitor, depth);
+  }
+
+
+  void Directory::freeze() {
+    _frozenTree = std::make_unique<FrozenTree>(*this);
+  }
+
+
+  const FrozenTree* Directory::findFrozenTree() const
+  {
+    for (const NodeIf* node = this; node != nullptr; node = node->getParent())
+    {
+      const auto* frozen = static_cast<const Directory*>(node)->getFrozenTree();
+      if (frozen) { return frozen; }
+    }
+
+    return nullptr;
+  }
+
+
+  const Directory& Directory::getRoot() const
+  {
+    const NodeIf* root = this;
+
+    while (root->getParent()) {
+      root = root->getParent();
+    }
+
+    return *static_cast<const Directory*>(root);
+  }
+
+
+  TreeViewCache& Directory::getViewCache() const
+  {
+    if (!_viewCache) {
+      _viewCache = std::make_unique<TreeViewCache>();
+    }
+
+    return *_viewCache;
+  }
+
+
+  NodeIf* Directory::findNodeById(uint32_t id) const
   {
-    visitor(*this, depth);
+    if (id == ROOT_ID) { return const_cast<Directory*>(this); }
+    if (id == INVALID_ID || id > _nodesById.size()) { return nullptr; }
 
-    for (const auto& child : _children)
+    return _nodesById[id - 1];
+  }
+
+
+  void Directory::registerSubtree(NodeIf& node)
+  {
+    auto& root = const_cast<Directory&>(getRoot());
+
+    // Leaves and empty directories are the common case
+    if (!node.isDirectory() || static_cast<Directory&>(node)._children.empty())
     {
-      NodeIf* node = getNodePtr(child);
+      root._nodesById.push_back(&node);
+      node._id = static_cast<uint32_t>(root._nodesById.size());
+      return;
+    }
 
-      if (node->isDirectory()) {
-        static_cast<const Directory*>(node)->traverse(visitor, depth + 1);
+    // Pre-order, the subtree's own IDs are dropped as it is no longer a root
+    std::vector<NodeIf*> stack{&node};
+
+    while (!stack.empty())
+    {
+      NodeIf* current = stack.back();
+      stack.pop_back();
+
+      root._nodesById.push_back(current);
+      current->_id = static_cast<uint32_t>(root._nodesById.size());
+
+      if (!current->isDirectory()) { continue; }
+
+      auto* dir = static_cast<Directory*>(current);
+      std::vector<NodeIf*>().swap(dir->_nodesById);
+
+      for (auto it = dir->_children.rbegin(); it != dir->_children.rend(); ++it) {
+        stack.push_back(getNodePtr(*it));
       }
-      else {
-        visitor(*node, depth + 1);
+    }
+  }
+
+
+  void Directory::invalidateCaches()
+  {
+    for (NodeIf* node = this; node != nullptr; node = node->getParent())
+    {
+      auto* dir = static_cast<Directory*>(node);
+      dir->_frozenTree.reset();
+
+      if (dir->_viewCache) {
+        dir->_viewCache->clear();
       }
     }
   }
 
 
-  NodeIf* Directory::resolvePath(std::string_view pathStr, const Directory& currentDir) const
+  void Directory::updateSubtreeAccessLevels()
   {
-    // Find the actual root by walking up the tree
-    const NodeIf* rootNode = this;
-    while (rootNode->getParent() != nullptr) {
-      rootNode = rootNode->getParent();
+    // Parents are updated before their children, so each node only looks one level up
+    std::vector<Directory*> stack{this};
+
+    while (!stack.empty())
+    {
+      Directory* dir = stack.back();
+      stack.pop_back();
+
+      for (const auto& child : dir->_children)
+      {
+        NodeIf* node = getNodePtr(child);
+        node->setParent(dir);
+
+        if (node->isDirectory()) {
+          stack.push_back(static_cast<Directory*>(node));
+        }
+      }
     }
+  }
 
-    // First remove const, then cast to Directory*
-    Directory* rootDir = const_cast<Directory*>(static_cast<const Directory*>(rootNode));
+
+  NodeIf* Directory::resolvePath(std::string_view pathStr, const Directory& currentDir) const
+  {
+    // Resolve from the actual root of the tree
+    Directory* rootDir = const_cast<Directory*>(&getRoot());
     PathResolver resolver(*rootDir);
     return resolver.resolveFromString(pathStr, currentDir);
   }
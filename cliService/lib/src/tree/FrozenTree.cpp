@@ -0,0 +1,108 @@
+#include "cliService/tree/FrozenTree.hpp"
+#include "cliService/tree/Directory.hpp"
+
+namespace cliService
+{
+
+  FrozenTree::FrozenTree(const Directory& root)
+  {
+    appendNode(const_cast<Directory&>(root), INVALID);
+
+    // Breadth first, so each directory's children are appended back to back
+    for (Index index = 0; index < _nodes.size(); ++index)
+    {
+      if (_kinds[index] != Kind::Directory) { continue; }
+
+      const auto* dir = static_cast<const Directory*>(_nodes[index]);
+      _firstChildren[index] = static_cast<Index>(_nodes.size());
+      _childCounts[index] = static_cast<Index>(dir->_children.size());
+
+      for (const auto& child : dir->_children) {
+        appendNode(*dir->getNodePtr(child), index);
+      }
+    }
+
+    _nameOffsets.push_back(static_cast<uint32_t>(_names.size()));
+  }
+
+
+  void FrozenTree::appendNode(NodeIf& node, Index parent)
+  {
+    _indexByNode.emplace(&node, static_cast<Index>(_nodes.size()));
+    _nodes.push_back(&node);
+
+    _nameOffsets.push_back(static_cast<uint32_t>(_names.size()));
+    _names += node.getName();
+
+    _parents.push_back(parent);
+    _firstChildren.push_back(0);
+    _childCounts.push_back(0);
+    _effectiveAccessLevels.push_back(node.getEffectiveAccessLevel());
+    _kinds.push_back(node.isDirectory() ? Kind::Directory : Kind::Command);
+  }
+
+
+  FrozenTree::Index FrozenTree::indexOf(const NodeIf& node) const
+  {
+    auto it = _indexByNode.find(&node);
+    return it == _indexByNode.end() ? INVALID : it->second;
+  }
+
+
+  FrozenTree::Index FrozenTree::findChild(Index dir, std::string_view name) const
+  {
+    const Index first = _firstChildren[dir];
+    const Index last = first + _childCounts[dir];
+
+    for (Index child = first; child < last; ++child) {
+      if (getName(child) == name) { return child; }
+    }
+
+    return INVALID;
+  }
+
+
+  FrozenTree::Index FrozenTree::resolve(const Path& path, Index current) const
+  {
+    Index node = path.isAbsolute() ? ROOT : current;
+
+    // Paths are normalized lexically, so ".." may cancel elements that don't
+    // exist. Count how deep below the last existing node we are.
+    size_t missingDepth = 0;
+
+    for (const auto& element : path.elements())
+    {
+      if (element.empty() || element == ".") { continue; }
+
+      if (element == "..")
+      {
+        if (missingDepth > 0) {
+          missingDepth--;
+        }
+        else if (_parents[node] != INVALID) {
+          node = _parents[node];
+        }
+
+        continue;
+      }
+
+      if (missingDepth > 0)
+      {
+        missingDepth++;
+        continue;
+      }
+
+      Index child = _kinds[node] == Kind::Directory ? findChild(node, element) : INVALID;
+
+      if (child == INVALID) {
+        missingDepth = 1;
+      }
+      else {
+        node = child;
+      }
+    }
+
+    return missingDepth > 0 ? INVALID : node;
+  }
+
+}
@@ -0,0 +1,270 @@
+#include "cliService/tree/OutputFilter.hpp"
+#include <cstdint>
+
+namespace cliService
+{
+
+  namespace
+  {
+
+    class GrepSource : public OutputSourceIf
+    {
+    public:
+      GrepSource(std::shared_ptr<OutputSourceIf> upstream, std::string pattern, bool invert)
+        : _upstream(std::move(upstream))
+        , _pattern(std::move(pattern))
+        , _invert(invert)
+      {}
+
+      bool nextLine(std::string& line) override
+      {
+        while (_upstream->nextLine(line))
+        {
+          const bool found = line.find(_pattern) != std::string::npos;
+          if (found != _invert) { return true; }
+        }
+
+        return false;
+      }
+
+    private:
+      std::shared_ptr<OutputSourceIf> _upstream;
+      std::string _pattern;
+      bool _invert;
+    };
+
+
+    class HeadSource : public OutputSourceIf
+    {
+    public:
+      HeadSource(std::shared_ptr<OutputSourceIf> upstream, size_t lineCount)
+        : _upstream(std::move(upstream))
+        , _linesLeft(lineCount)
+      {}
+
+      bool nextLine(std::string& line) override
+      {
+        if (_linesLeft > 0 && _upstream && _upstream->nextLine(line))
+        {
+          _linesLeft--;
+          return true;
+        }
+
+        // Nothing more is pulled, release the generator right away
+        _upstream.reset();
+        return false;
+      }
+
+    private:
+      std::shared_ptr<OutputSourceIf> _upstream;
+      size_t _linesLeft;
+    };
+
+
+    class TailSource : public OutputSourceIf
+    {
+    public:
+      TailSource(std::shared_ptr<OutputSourceIf> upstream, size_t lineCount)
+        : _upstream(std::move(upstream))
+        , _lineCount(lineCount)
+      {}
+
+      bool nextLine(std::string& line) override
+      {
+        if (_upstream) { collect(); }
+
+        if (_emitted == _lines.size()) { return false; }
+
+        line = _lines[(_first + _emitted++) % _lines.size()];
+        return true;
+      }
+
+    private:
+      // Drain the upstream into a ring of the last _lineCount lines
+      void collect()
+      {
+        std::string line;
+        size_t total = 0;
+
+        while (_upstream->nextLine(line))
+        {
+          if (_lineCount == 0) { continue; }
+
+          if (_lines.size() < _lineCount) {
+            _lines.push_back(line);
+          }
+          else {
+            _lines[total % _lineCount].swap(line);
+          }
+
+          total++;
+        }
+
+        _upstream.reset();
+
+        // Once the ring wrapped, the oldest kept line sits at the write position
+        _first = (_lines.size() < _lineCount || _lineCount == 0) ? 0 : total % _lineCount;
+      }
+
+      std::shared_ptr<OutputSourceIf> _upstream;
+      const size_t _lineCount;
+      std::vector<std::string> _lines;
+      size_t _first = 0;
+      size_t _emitted = 0;
+    };
+
+
+    class CountSource : public OutputSourceIf
+    {
+    public:
+      explicit CountSource(std::shared_ptr<OutputSourceIf> upstream)
+        : _upstream(std::move(upstream))
+      {}
+
+      bool nextLine(std::string& line) override
+      {
+        if (!_upstream) { return false; }
+
+        size_t count = 0;
+
+        while (_upstream->nextLine(line)) {
+          count++;
+        }
+
+        _upstream.reset();
+        line = std::to_string(count);
+        return true;
+      }
+
+    private:
+      std::shared_ptr<OutputSourceIf> _upstream;
+    };
+
+
+    bool parseLineCount(const std::string& text, size_t maxCount, size_t& count)
+    {
+      if (text.empty()) { return false; }
+
+      size_t value = 0;
+
+      for (char c : text)
+      {
+        if (c < '0' || c > '9') { return false; }
+        value = value * 10 + static_cast<size_t>(c - '0');
+
+        if (value > maxCount) { return false; }
+      }
+
+      count = value;
+      return true;
+    }
+
+  }
+
+
+  std::optional<OutputFilter> OutputFilter::parse(const std::vector<std::string>& words)
+  {
+    if (words.empty()) { return std::nullopt; }
+
+    const std::string& name = words.front();
+
+    if (name == "grep")
+    {
+      OutputFilter filter(Kind::Grep);
+      size_t first = 1;
+
+      if (words.size() > 1 && words[1] == "-v")
+      {
+        filter._invert = true;
+        first = 2;
+      }
+
+      if (first >= words.size()) { return std::nullopt; }
+
+      // Arguments are split at spaces, so several words form one pattern
+      for (size_t i = first; i < words.size(); ++i)
+      {
+        if (i > first) { filter._pattern += ' '; }
+        filter._pattern += words[i];
+      }
+
+      return filter;
+    }
+
+    if (name == "head" || name == "tail")
+    {
+      OutputFilter filter(name == "head" ? Kind::Head : Kind::Tail);
+      const size_t maxCount = filter._kind == Kind::Tail ? MAX_TAIL_LINES : SIZE_MAX / 10;
+
+      if (words.size() > 2) { return std::nullopt; }
+      if (words.size() == 2 && !parseLineCount(words[1], maxCount, filter._lineCount)) { return std::nullopt; }
+
+      return filter;
+    }
+
+    if (name == "count" && words.size() == 1) {
+      return OutputFilter(Kind::Count);
+    }
+
+    return std::nullopt;
+  }
+
+
+  std::shared_ptr<OutputSourceIf> OutputFilter::apply(std::shared_ptr<OutputSourceIf> upstream) const
+  {
+    switch (_kind)
+    {
+    case Kind::Grep:
+      return std::make_shared<GrepSource>(std::move(upstream), _pattern, _invert);
+    case Kind::Head:
+      return std::make_shared<HeadSource>(std::move(upstream), _lineCount);
+    case Kind::Tail:
+      return std::make_shared<TailSource>(std::move(upstream), _lineCount);
+    case Kind::Count:
+    default:
+      return std::make_shared<CountSource>(std::move(upstream));
+    }
+  }
+
+
+  MessageLineSource::MessageLineSource(std::string message, std::string_view newLine, std::shared_ptr<OutputSourceIf> rest)
+    : _message(std::move(message))
+    , _newLine(newLine)
+    , _rest(std::move(rest))
+  {
+    // A trailing line break does not start another line
+    if (_message.empty()) {
+      _offset = std::string::npos;
+    }
+    else if (_message.length() >= _newLine.length() &&
+             _message.compare(_message.length() - _newLine.length(), _newLine.length(), _newLine) == 0)
+    {
+      _message.resize(_message.length() - _newLine.length());
+    }
+  }
+
+
+  bool MessageLineSource::nextLine(std::string& line)
+  {
+    if (_offset != std::string::npos)
+    {
+      const size_t end = _message.find(_newLine, _offset);
+
+      if (end == std::string::npos)
+      {
+        line.assign(_message, _offset, std::string::npos);
+        _offset = std::string::npos;
+      }
+      else
+      {
+        line.assign(_message, _offset, end - _offset);
+        _offset = end + _newLine.length();
+      }
+
+      return true;
+    }
+
+    return _rest && _rest->nextLine(line);
+  }
+
+}
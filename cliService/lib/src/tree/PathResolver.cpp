@@ -17,6 +17,18 @@ namespace cliService
 
   NodeIf* PathResolver::resolve(const Path& path, const Directory& currentDir) const 
   {
+    // Use the compacted snapshot when the tree has been frozen
+    if (const FrozenTree* frozen = _root.getFrozenTree())
+    {
+      FrozenTree::Index current = path.isAbsolute() ? FrozenTree::ROOT : frozen->indexOf(currentDir);
+
+      if (current != FrozenTree::INVALID)
+      {
+        FrozenTree::Index index = frozen->resolve(path, current);
+        return index == FrozenTree::INVALID ? nullptr : frozen->getNode(index);
+      }
+    }
+
     // For relative paths, first convert to absolute by combining with current directory path
     if (!path.isAbsolute())
     {
@@ -0,0 +1,97 @@
+#include "cliService/tree/TreeOutputSource.hpp"
+#include "cliService/tree/CommandIf.hpp"
+#include "cliService/tree/Directory.hpp"
+
+namespace cliService
+{
+
+  TreeOutputSource::TreeOutputSource(const Directory& start, AccessLevel level, bool showCmdDescription, size_t maxDepth)
+    : _start(start)
+    , _level(level)
+    , _showCmdDescription(showCmdDescription)
+    , _maxDepth(maxDepth)
+  {}
+
+
+  bool TreeOutputSource::nextLine(std::string& line)
+  {
+    size_t depth = 0;
+    const NodeIf* node = nextNode(depth);
+
+    if (!node) { return false; }
+
+    line.clear();
+    formatNode(*node, depth, _showCmdDescription, line);
+
+    if (_showIds)
+    {
+      line += " #";
+      line += std::to_string(node->getId());
+    }
+
+    return true;
+  }
+
+
+  void TreeOutputSource::formatNode(const NodeIf& node, size_t depth, bool showCmdDescription, std::string& line)
+  {
+    line.append(depth * INDENT_WIDTH, ' ');
+    line += node.getName();
+
+    if (node.isDirectory()) {
+      line += '/';
+    }
+    else if (showCmdDescription)
+    {
+      const auto& description = static_cast<const CommandIf&>(node).getDescription();
+
+      if (!description.empty())
+      {
+        line += " - ";
+        line += description;
+      }
+    }
+  }
+
+
+  const NodeIf* TreeOutputSource::nextNode(size_t& depth)
+  {
+    if (!_startEmitted)
+    {
+      _startEmitted = true;
+
+      if (_start.getEffectiveAccessLevel() > _level) { return nullptr; }
+      if (_maxDepth > 0) { _stack.push_back({&_start, 0, 1}); }
+
+      depth = 0;
+      return &_start;
+    }
+
+    while (!_stack.empty())
+    {
+      auto& frame = _stack.back();
+
+      if (frame.nextChild >= frame.dir->getChildCount())
+      {
+        _stack.pop_back();
+        continue;
+      }
+
+      const NodeIf* child = frame.dir->getChild(frame.nextChild++);
+
+      // Nothing below an inaccessible node is shown
+      if (child->getEffectiveAccessLevel() > _level) { continue; }
+
+      depth = frame.depth;
+
+      if (child->isDirectory() && depth < _maxDepth) {
+        _stack.push_back({static_cast<const Directory*>(child), 0, depth + 1});
+      }
+
+      return child;
+    }
+
+    return nullptr;
+  }
+
+}
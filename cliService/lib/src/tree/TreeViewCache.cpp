@@ -0,0 +1,72 @@
+#include "cliService/tree/TreeViewCache.hpp"
+#include "cliService/tree/Directory.hpp"
+#include <algorithm>
+#include <cassert>
+
+namespace cliService
+{
+
+  std::vector<std::string> TreeViewCache::getCompletions(const Directory& dir, AccessLevel level, std::string_view prefix)
+  {
+    const auto& index = getMutableView(dir, level).completionIndex;
+
+    // Entries sharing a prefix are contiguous in sorted order
+    auto it = std::lower_bound(index.begin(), index.end(), prefix,
+      [](const std::string& option, std::string_view value) {
+        return std::string_view(option) < value;
+      });
+
+    std::vector<std::string> options;
+
+    for (; it != index.end() && it->compare(0, prefix.length(), prefix) == 0; ++it) {
+      options.push_back(*it);
+    }
+
+    return options;
+  }
+
+
+  TreeViewCache::DirectoryView& TreeViewCache::getMutableView(const Directory& dir, AccessLevel level)
+  {
+    const auto levelIndex = static_cast<size_t>(level);
+    assert(static_cast<int>(level) >= 0 && "Access levels must be non-negative");
+
+    if (levelIndex >= _levels.size()) {
+      _levels.resize(levelIndex + 1);
+    }
+
+    auto& views = _levels[levelIndex];
+    auto it = views.find(&dir);
+
+    if (it == views.end()) {
+      it = views.emplace(&dir, buildView(dir, level)).first;
+    }
+
+    return it->second;
+  }
+
+
+  TreeViewCache::DirectoryView TreeViewCache::buildView(const Directory& dir, AccessLevel level)
+  {
+    DirectoryView view;
+
+    dir.visit([&](const NodeIf& node, size_t depth) {
+      if (depth == 0) { return TraversalAction::Continue; }
+
+      if (node.getEffectiveAccessLevel() <= level)
+      {
+        view.visibleChildren.push_back(&node);
+        view.completionIndex.push_back(node.getName() + (node.isDirectory() ? "/" : ""));
+      }
+
+      return TraversalAction::SkipChildren;
+    });
+
+    std::sort(view.completionIndex.begin(), view.completionIndex.end());
+    _buildCount++;
+
+    return view;
+  }
+
+
+}
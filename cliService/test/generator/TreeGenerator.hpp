@@ -0,0 +1,186 @@
+#pragma once
+#include "cliService/tree/Directory.hpp"
+#include "cliService/tree/CommandIf.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace cliService
+{
+
+  // Shape of a synthetic tree. Every directory above 'depth' gets 'fanOut'
+  // children, of which a 'commandRatio' share are commands and the rest
+  // directories. Everything at 'depth' is a command. Generation stops once
+  // 'maxNodes' nodes (including the root) exist.
+  struct TreeGeneratorConfig
+  {
+    size_t depth = 3;
+    size_t fanOut = 8;
+    double commandRatio = 0.5;
+
+    // Name lengths are uniformly distributed over [min, max]
+    size_t minNameLength = 4;
+    size_t maxNameLength = 12;
+
+    // A 'restrictedRatio' share of the nodes gets 'restrictedLevel'
+    AccessLevel publicLevel{};
+    AccessLevel restrictedLevel{};
+    double restrictedRatio = 0.0;
+
+    size_t maxNodes = 1000000;
+    uint32_t seed = 1;
+  };
+
+  struct GeneratedTreeStats
+  {
+    size_t nodeCount = 0;
+    size_t directoryCount = 0;
+    size_t commandCount = 0;
+    size_t restrictedCount = 0;
+    size_t nameBytes = 0;
+    size_t maxDepth = 0;
+    double buildTime_ms = 0.0;
+  };
+
+  // Command used for all generated leaves, replies with its own name
+  class GeneratedCommand : public CommandIf
+  {
+  public:
+    using CommandIf::CommandIf;
+
+    CLIResponse execute(const std::vector<std::string>& args) override
+    {
+      (void)(args);
+      return CLIResponse::success(getName());
+    }
+  };
+
+  class TreeGenerator
+  {
+  public:
+    explicit TreeGenerator(TreeGeneratorConfig config)
+      : _config(std::move(config))
+      , _random(_config.seed)
+    {}
+
+    // Builds a new tree, deterministic for a given configuration
+    std::unique_ptr<Directory> generate()
+    {
+      const auto start = std::chrono::steady_clock::now();
+
+      _stats = GeneratedTreeStats{};
+      auto root = std::make_unique<Directory>("root", _config.publicLevel);
+      countNode(*root, 0);
+
+      // Breadth first, so 'maxNodes' truncates the deepest level first
+      std::deque<std::pair<Directory*, size_t>> pending{{root.get(), 0}};
+
+      while (!pending.empty() && _stats.nodeCount < _config.maxNodes)
+      {
+        auto [dir, depth] = pending.front();
+        pending.pop_front();
+
+        if (depth >= _config.depth) { continue; }
+
+        std::unordered_set<std::string> siblingNames;
+
+        for (size_t i = 0; i < _config.fanOut && _stats.nodeCount < _config.maxNodes; ++i)
+        {
+          const auto name = uniqueName(siblingNames);
+          const auto level = pickAccessLevel();
+          const bool isCommand = depth + 1 == _config.depth || chance(_config.commandRatio);
+
+          if (isCommand) {
+            countNode(dir->addDynamicCommand<GeneratedCommand>(name, level), depth + 1);
+          }
+          else
+          {
+            auto& child = dir->addDynamicDirectory(name, level);
+            countNode(child, depth + 1);
+            pending.emplace_back(&child, depth + 1);
+          }
+        }
+      }
+
+      _stats.buildTime_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+      return root;
+    }
+
+    const GeneratedTreeStats& getStats() const { return _stats; }
+
+    // Number of nodes a configuration produces at most, ignoring 'maxNodes'
+    static size_t upperBoundNodeCount(const TreeGeneratorConfig& config)
+    {
+      size_t total = 1;
+      size_t levelCount = 1;
+
+      for (size_t depth = 0; depth < config.depth; ++depth)
+      {
+        levelCount *= config.fanOut;
+        total += levelCount;
+      }
+
+      return total;
+    }
+
+  private:
+    bool chance(double ratio)
+    {
+      return ratio > 0.0 && std::uniform_real_distribution<double>(0.0, 1.0)(_random) < ratio;
+    }
+
+    AccessLevel pickAccessLevel()
+    {
+      return chance(_config.restrictedRatio) ? _config.restrictedLevel : _config.publicLevel;
+    }
+
+    std::string uniqueName(std::unordered_set<std::string>& siblingNames)
+    {
+      std::uniform_int_distribution<size_t> lengths(_config.minNameLength, _config.maxNameLength);
+      std::uniform_int_distribution<int> letters('a', 'z');
+
+      std::string name(std::max<size_t>(lengths(_random), 1), ' ');
+      for (auto& c : name) { c = static_cast<char>(letters(_random)); }
+
+      // Short names collide easily, disambiguate with a counter
+      for (size_t suffix = 0; !siblingNames.insert(name).second; ++suffix)
+      {
+        if (suffix > 0) { name.erase(name.find_last_of('_')); }
+        name += "_" + std::to_string(suffix);
+      }
+
+      return name;
+    }
+
+    void countNode(const NodeIf& node, size_t depth)
+    {
+      _stats.nodeCount++;
+      _stats.nameBytes += node.getName().size();
+      _stats.maxDepth = std::max(_stats.maxDepth, depth);
+
+      if (node.isDirectory()) {
+        _stats.directoryCount++;
+      }
+      else {
+        _stats.commandCount++;
+      }
+
+      if (node.getAccessLevel() == _config.restrictedLevel && _config.restrictedLevel != _config.publicLevel) {
+        _stats.restrictedCount++;
+      }
+    }
+
+    TreeGeneratorConfig _config;
+    std::mt19937 _random;
+    GeneratedTreeStats _stats;
+  };
+
+}
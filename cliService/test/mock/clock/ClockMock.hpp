@@ -0,0 +1,21 @@
+#pragma once
+#include "cliService/cli/ClockIf.hpp"
+
+namespace cliService
+{
+
+  // Manually advanced clock, time only moves when the test says so
+  class ClockMock : public ClockIf
+  {
+  public:
+    uint64_t now_us() const override { return _now_us; }
+
+    void setTime_us(uint64_t time_us) { _now_us = time_us; }
+    void advance_us(uint64_t delta_us) { _now_us += delta_us; }
+    void advance_ms(uint64_t delta_ms) { _now_us += delta_ms * 1000; }
+
+  private:
+    uint64_t _now_us = 0;
+  };
+
+}
@@ -0,0 +1,214 @@
+#include "gtest/gtest.h"
+#include "cliService/cli/CLIService.hpp"
+#include "cliService/cli/RingBufferTracer.hpp"
+#include "mock/command/CommandMock.hpp"
+#include "mock/io/CharIOStreamMock.hpp"
+#include "generator/TreeGenerator.hpp"
+#include "util/AllocationCounter.hpp"
+
+namespace cliService
+{
+
+  // Allocation budgets of the interactive hot paths. Keystrokes that only edit
+  // the line must not allocate at all; the budgets of the other operations are
+  // upper bounds to be lowered, never raised, as the library improves.
+  class AllocationBudgetTest : public ::testing::Test
+  {
+  protected:
+    // Plain command, so no mocking framework bookkeeping is counted
+    class ReplyCommand : public CommandIf
+    {
+    public:
+      using CommandIf::CommandIf;
+
+      CLIResponse execute(const std::vector<std::string>& args) override
+      {
+        (void)(args);
+        return CLIResponse::success(std::string_view("ok"));
+      }
+    };
+
+    void SetUp() override
+    {
+      root = std::make_unique<Directory>("root", AccessLevel::User);
+      auto& system = root->addDynamicDirectory("system", AccessLevel::User);
+      system.addDynamicCommand<ReplyCommand>("status", AccessLevel::User);
+      system.addDynamicCommand<ReplyCommand>("stats", AccessLevel::User);
+      system.addDynamicCommand<ReplyCommand>("reboot", AccessLevel::Admin);
+      root->addDynamicCommand<ReplyCommand>("hello", AccessLevel::User);
+
+      users = {{"user", "user123", AccessLevel::User}};
+      service = std::make_unique<CLIService>(CLIServiceConfiguration{ioStream, users, *root, 1000, 10});
+      service->activate();
+      send("user:user123\n");
+
+      // Warm up: exercise every path once so buffers reach their steady size
+      send("system/status\n");
+      send("hello\n");
+      send("system/st\t");
+      send("\x1b[A");
+      send("\x1b[B");
+      send("\x7f\x7f\x7f\x7f\x7f\x7f\x7f\x7f\x7f\x7f\x7f\x7f\x7f\x7f\x7f");
+      ioStream.clearOutput();
+    }
+
+    // Feed 'input' and service until it has been consumed
+    void send(const std::string& input)
+    {
+      ioStream.queueInput(input);
+      while (ioStream.available()) {
+        service->service();
+      }
+    }
+
+    // Allocations made while servicing 'input', which is queued beforehand
+    AllocationCounter::Counts measure(const std::string& input)
+    {
+      ioStream.queueInput(input);
+
+      AllocationCounter counter;
+      while (ioStream.available()) {
+        service->service();
+      }
+
+      auto counts = counter.stop();
+      ioStream.clearOutput();
+      return counts;
+    }
+
+    std::unique_ptr<Directory> root;
+    std::vector<User> users;
+    CharIOStreamMock ioStream;
+    std::unique_ptr<CLIService> service;
+  };
+
+  TEST_F(AllocationBudgetTest, CounterSeesAllocations)
+  {
+    AllocationCounter counter;
+    auto value = std::make_unique<int>(42);
+    auto counts = counter.stop();
+
+    EXPECT_EQ(counts.allocations, 1u);
+    EXPECT_EQ(counts.bytes, sizeof(int));
+  }
+
+  TEST_F(AllocationBudgetTest, EchoCharacter)
+  {
+    auto counts = measure("h");
+    EXPECT_EQ(counts.allocations, 0u) << counts.bytes << " bytes";
+  }
+
+  TEST_F(AllocationBudgetTest, EchoLongLine)
+  {
+    auto counts = measure(std::string(InputParser::LINE_BUFFER_CAPACITY - 1, 'x'));
+    EXPECT_EQ(counts.allocations, 0u) << counts.bytes << " bytes";
+  }
+
+  TEST_F(AllocationBudgetTest, EchoMaskedPassword)
+  {
+    send("logout\n");
+    send("user:");
+    auto counts = measure("user123");
+    EXPECT_EQ(counts.allocations, 0u) << counts.bytes << " bytes";
+  }
+
+  TEST_F(AllocationBudgetTest, Backspace)
+  {
+    send("hello");
+    auto counts = measure("\x7f");
+    EXPECT_EQ(counts.allocations, 0u) << counts.bytes << " bytes";
+  }
+
+  TEST_F(AllocationBudgetTest, TabCompletion)
+  {
+    send("system/st");
+    auto counts = measure("\t");
+    EXPECT_LE(counts.allocations, 23u) << counts.bytes << " bytes";
+  }
+
+  TEST_F(AllocationBudgetTest, HistoryNavigation)
+  {
+    auto up = measure("\x1b[A");
+    EXPECT_LE(up.allocations, 1u) << up.bytes << " bytes";
+
+    auto down = measure("\x1b[B");
+    EXPECT_LE(down.allocations, 1u) << down.bytes << " bytes";
+  }
+
+  TEST_F(AllocationBudgetTest, ExecuteCommand)
+  {
+    send("system/status");
+    auto counts = measure("\n");
+    EXPECT_LE(counts.allocations, 10u) << counts.bytes << " bytes";
+  }
+
+  TEST_F(AllocationBudgetTest, TracingAddsNoAllocations)
+  {
+    RingBufferTracer tracer(64);
+    CharIOStreamMock tracedStream;
+    CLIServiceConfiguration config{tracedStream, users, *root, 1000, 10};
+    config._tracer = &tracer;
+    CLIService tracedService(std::move(config));
+
+    tracedService.activate();
+    tracedStream.queueInput("user:user123\nsystem/status\nsystem/status");
+    while (tracedStream.available()) {
+      tracedService.service();
+    }
+    tracedStream.clearOutput();
+    tracedStream.queueInput("\n");
+
+    AllocationCounter counter;
+    tracedService.service();
+    auto counts = counter.stop();
+
+    EXPECT_GT(tracer.size(), 0u);
+    EXPECT_LE(counts.allocations, 10u) << counts.bytes << " bytes";
+  }
+
+  // Discards output, so only the library's own allocations are counted
+  class CountingCharIOStream : public CharIOStreamMock
+  {
+  public:
+    bool putChar(char c) override
+    {
+      (void)(c);
+      written++;
+      return true;
+    }
+
+    size_t written = 0;
+  };
+
+  TEST_F(AllocationBudgetTest, TreeStreamsLargeTreesInBoundedMemory)
+  {
+    TreeGeneratorConfig treeConfig;
+    treeConfig.depth = 4;
+    treeConfig.fanOut = 10;
+    treeConfig.commandRatio = 0.0;
+    treeConfig.publicLevel = AccessLevel::User;
+    TreeGenerator generator(treeConfig);
+    auto largeRoot = generator.generate();
+
+    CountingCharIOStream sink;
+    CLIService largeService(CLIServiceConfiguration{sink, users, *largeRoot, 1000, 10});
+    largeService.activate();
+    sink.queueInput("user:user123\ntree");
+    while (sink.available()) {
+      largeService.service();
+    }
+
+    sink.written = 0;
+    sink.queueInput("\n");
+
+    AllocationCounter counter;
+    largeService.service();
+    auto counts = counter.stop();
+
+    // 11111 lines are written, memory only depends on the depth of the tree
+    EXPECT_GT(sink.written, 11111u * 4);
+    EXPECT_LE(counts.allocations, 20u) << counts.bytes << " bytes";
+    EXPECT_LE(counts.bytes, 1024u);
+  }
+
+}
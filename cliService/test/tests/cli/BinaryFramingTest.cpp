@@ -0,0 +1,259 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "cliService/cli/BinaryFraming.hpp"
+#include "cliService/cli/CLIService.hpp"
+#include "mock/clock/ClockMock.hpp"
+#include "mock/command/CommandMock.hpp"
+#include "mock/io/CharIOStreamMock.hpp"
+
+namespace cliService
+{
+
+  TEST(BinaryFrameDecoderTest, Varints)
+  {
+    for (uint32_t value : {0u, 1u, 127u, 128u, 300u, 16384u, 0xFFFFFFFFu})
+    {
+      std::string bytes;
+      BinaryFrameDecoder::appendVarint(value, bytes);
+
+      std::string_view in = bytes;
+      uint32_t decoded = 0;
+      ASSERT_TRUE(BinaryFrameDecoder::readVarint(in, decoded)) << value;
+      EXPECT_EQ(decoded, value);
+      EXPECT_TRUE(in.empty());
+    }
+
+    std::string bytes;
+    BinaryFrameDecoder::appendVarint(300, bytes);
+    EXPECT_EQ(bytes, "\xAC\x02");
+
+    std::string_view truncated = "\x80";
+    uint32_t value = 0;
+    EXPECT_FALSE(BinaryFrameDecoder::readVarint(truncated, value));
+  }
+
+  TEST(BinaryFrameDecoderTest, DecodesRequests)
+  {
+    BinaryFrameDecoder decoder;
+    std::string frames;
+    encodeBinaryRequest(5, {"1", "255", ""}, frames);
+    encodeBinaryRequest(300, {}, frames);
+
+    std::vector<BinaryFrameDecoder::Result> results;
+    for (char c : frames) { results.push_back(decoder.push(c)); }
+
+    // Two complete frames, fed byte by byte
+    const size_t firstEnd = 1 + frames[0];
+    EXPECT_EQ(results[firstEnd - 1], BinaryFrameDecoder::Result::Complete);
+    EXPECT_EQ(results.back(), BinaryFrameDecoder::Result::Complete);
+    EXPECT_EQ(std::count(results.begin(), results.end(), BinaryFrameDecoder::Result::Complete), 2);
+    EXPECT_EQ(decoder.getNodeId(), 300u);
+    EXPECT_TRUE(decoder.getArgs().empty());
+  }
+
+  TEST(BinaryFrameDecoderTest, RecoversFromMalformedFrames)
+  {
+    BinaryFrameDecoder decoder;
+
+    // Argument longer than the frame
+    std::string bad = "\x03\x01\x01\x05";
+    EXPECT_EQ(decoder.push(bad[0]), BinaryFrameDecoder::Result::Incomplete);
+    EXPECT_EQ(decoder.push(bad[1]), BinaryFrameDecoder::Result::Incomplete);
+    EXPECT_EQ(decoder.push(bad[2]), BinaryFrameDecoder::Result::Incomplete);
+    EXPECT_EQ(decoder.push(bad[3]), BinaryFrameDecoder::Result::Malformed);
+
+    // A corrupted length is rejected right away instead of skipping up to 4 GiB
+    std::string oversized;
+    BinaryFrameDecoder::appendVarint(0xFFFFFFFF, oversized);
+
+    std::vector<BinaryFrameDecoder::Result> results;
+    for (char c : oversized) { results.push_back(decoder.push(c)); }
+    EXPECT_EQ(results.back(), BinaryFrameDecoder::Result::Malformed);
+
+    // Zero length frames are ignored, a pending frame can be dropped
+    EXPECT_EQ(decoder.push('\0'), BinaryFrameDecoder::Result::Incomplete);
+    EXPECT_FALSE(decoder.isPending());
+    decoder.push('\x05');
+    decoder.push('\x01');
+    EXPECT_TRUE(decoder.isPending());
+    decoder.reset();
+    EXPECT_FALSE(decoder.isPending());
+
+    std::string good;
+    encodeBinaryRequest(7, {"a"}, good);
+    BinaryFrameDecoder::Result last = BinaryFrameDecoder::Result::Incomplete;
+    for (char c : good) { last = decoder.push(c); }
+
+    EXPECT_EQ(last, BinaryFrameDecoder::Result::Complete);
+    EXPECT_EQ(decoder.getNodeId(), 7u);
+    EXPECT_EQ(decoder.getArgs(), std::vector<std::string>{"a"});
+  }
+
+
+  class BinaryModeTest : public ::testing::Test
+  {
+  protected:
+    struct Response
+    {
+      int status;
+      std::string body;
+    };
+
+    void SetUp() override
+    {
+      // IDs in the order nodes are added: root 0, hw 1, rgb 2, set 3, secret 4
+      auto root = std::make_unique<Directory>("root", AccessLevel::User);
+      auto& hw = root->addDynamicDirectory("hw", AccessLevel::User);
+      auto& rgb = hw.addDynamicDirectory("rgb", AccessLevel::User);
+      _setCmd = &rgb.addDynamicCommand<CommandMock>("set", AccessLevel::User);
+      root->addDynamicCommand<CommandMock>("secret", AccessLevel::Admin);
+
+      ON_CALL(*_setCmd, execute(testing::_)).WillByDefault([](const std::vector<std::string>& args) {
+        std::string joined;
+        for (const auto& arg : args) { joined += arg + ";"; }
+        return CLIResponse::success(joined);
+      });
+
+      CLIServiceConfiguration config{_ioStream, {{"user", "user123", AccessLevel::User}}, std::move(root), 1000, 10};
+      config._clock = &_clock;
+      _service = std::make_unique<CLIService>(std::move(config));
+      _service->activate();
+
+      _ioStream.queueInput("user:user123\nmode binary\n");
+      _service->service();
+      _service->service();
+      _ioStream.clearOutput();
+    }
+
+    void sendFrame(uint32_t nodeId, const std::vector<std::string>& args)
+    {
+      std::string frame;
+      encodeBinaryRequest(nodeId, args, frame);
+      _ioStream.queueInput(frame);
+      _service->service();
+    }
+
+    std::vector<Response> responses() const
+    {
+      std::vector<Response> result;
+      const std::string output = _ioStream.getOutput();
+      std::string_view in = output;
+
+      while (!in.empty())
+      {
+        const int status = static_cast<uint8_t>(in.front());
+        in.remove_prefix(1);
+
+        uint32_t length = 0;
+        if (!BinaryFrameDecoder::readVarint(in, length) || length > in.length()) { ADD_FAILURE() << "Bad response"; break; }
+
+        result.push_back({status, std::string(in.substr(0, length))});
+        in.remove_prefix(length);
+      }
+
+      return result;
+    }
+
+    ClockMock _clock;
+    CharIOStreamMock _ioStream;
+    CommandMock* _setCmd;
+    std::unique_ptr<CLIService> _service;
+  };
+
+  TEST_F(BinaryModeTest, DispatchesByNodeId)
+  {
+    EXPECT_CALL(*_setCmd, execute(std::vector<std::string>{"1", "255", "0", "0"}));
+
+    sendFrame(3, {"1", "255", "0", "0"});
+
+    const auto result = responses();
+    ASSERT_EQ(result.size(), 1u);
+    EXPECT_EQ(result[0].status, static_cast<int>(CLIResponse::Status::Success));
+    EXPECT_EQ(result[0].body, "1;255;0;0;");
+  }
+
+  TEST_F(BinaryModeTest, ErrorsCarryStatus)
+  {
+    sendFrame(4, {});
+    sendFrame(99, {});
+    _ioStream.queueInput(std::string("\x02\x03\x01", 3));
+    _service->service();
+
+    const auto result = responses();
+    ASSERT_EQ(result.size(), 3u);
+    EXPECT_EQ(result[0].status, static_cast<int>(CLIResponse::Status::AccessDenied));
+    EXPECT_EQ(result[1].status, static_cast<int>(CLIResponse::Status::InvalidPath));
+    EXPECT_EQ(result[2].status, static_cast<int>(CLIResponse::Status::InvalidArguments));
+  }
+
+  TEST_F(BinaryModeTest, PipelinedFramesAnswerInOrder)
+  {
+    std::string frames;
+    encodeBinaryRequest(3, {"a"}, frames);
+    encodeBinaryRequest(3, {"b"}, frames);
+    encodeBinaryRequest(3, {"c"}, frames);
+    _ioStream.queueInput(frames);
+    _service->service();
+
+    const auto result = responses();
+    ASSERT_EQ(result.size(), 3u);
+    EXPECT_EQ(result[0].body, "a;");
+    EXPECT_EQ(result[1].body, "b;");
+    EXPECT_EQ(result[2].body, "c;");
+  }
+
+  TEST_F(BinaryModeTest, TreeListsNodeIdsAndRootLeavesBinaryMode)
+  {
+    sendFrame(0, {});
+
+    auto result = responses();
+    ASSERT_EQ(result.size(), 1u);
+    EXPECT_EQ(result[0].body, "human");
+
+    _ioStream.clearOutput();
+    _ioStream.queueInput("tree -i\n");
+    _service->service();
+
+    const std::string output = _ioStream.getOutput();
+    EXPECT_THAT(output, testing::HasSubstr("root/ #0\r\n"));
+    EXPECT_THAT(output, testing::HasSubstr("      set #3\r\n"));
+    EXPECT_THAT(output, testing::Not(testing::HasSubstr("secret")));
+  }
+
+  TEST_F(BinaryModeTest, CorruptedLengthDoesNotSwallowTheSession)
+  {
+    std::string input;
+    BinaryFrameDecoder::appendVarint(0xFFFFFFFF, input);
+    encodeBinaryRequest(0, {}, input);
+    _ioStream.queueInput(input);
+    _service->service();
+
+    const auto result = responses();
+    ASSERT_EQ(result.size(), 2u);
+    EXPECT_EQ(result[0].status, static_cast<int>(CLIResponse::Status::InvalidArguments));
+    EXPECT_EQ(result[1].body, "human");
+  }
+
+  TEST_F(BinaryModeTest, SilenceDropsAPendingFrame)
+  {
+    EXPECT_CALL(*_setCmd, execute(testing::_)).Times(1);
+
+    // Cut short after the node ID, nothing a client could pad it with is needed
+    _ioStream.queueInput(std::string("\x04\x03", 2));
+    _service->service();
+
+    // A pause shorter than the input timeout keeps the frame
+    _clock.advance_ms(999);
+    _ioStream.queueInput(std::string("\x01", 1));
+    _service->service();
+    EXPECT_TRUE(responses().empty());
+
+    _clock.advance_ms(1000);
+    sendFrame(3, {"x"});
+
+    const auto result = responses();
+    ASSERT_EQ(result.size(), 1u);
+    EXPECT_EQ(result[0].body, "x;");
+  }
+
+}
@@ -1,6 +1,7 @@
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
 #include "cliService/cli/CLIService.hpp"
+#include "mock/clock/ClockMock.hpp"
 #include "mock/command/CommandMock.hpp"
 #include "mock/io/CharIOStreamMock.hpp"
 
@@ -54,11 +55,13 @@ namespace cliService
         HISTORY_SIZE,
         std::move(messages)
       };
+      config._clock = &_clock;
 
       _service = std::make_unique<CLIService>(std::move(config));
     }
 
     CharIOStreamMock _ioStream;
+    ClockMock _clock;
     Directory* _rootDir;
     CommandMock* _adminCmd;
     CommandMock* _publicCmd;
@@ -244,7 +247,6 @@ namespace cliService
 
     std::vector<std::string> commands = {
       "help arg\n",
-      "tree arg\n",
       "logout arg\n",
       "exit arg\n"
     };
@@ -310,6 +312,28 @@ namespace cliService
     EXPECT_THAT(adminOutput, testing::HasSubstr("admin/"));
   }
 
+  TEST_F(CLIServiceTest, RestrictedDirectoryHidesAccessibleChildren)
+  {
+    // User level command inside an Admin directory
+    auto& adminDir = *static_cast<Directory*>(_rootDir->findNode({"admin"}));
+    auto& hiddenCmd = adminDir.addDynamicCommand<CommandMock>("status", AccessLevel::User, "Hidden status");
+
+    _service->activate();
+    _ioStream.queueInput("user:user123\n");
+    _service->service();
+
+    _ioStream.clearOutput();
+    _ioStream.queueInput("tree\n");
+    _service->service();
+    EXPECT_THAT(_ioStream.getOutput(), testing::Not(testing::HasSubstr("status")));
+
+    EXPECT_CALL(hiddenCmd, execute(testing::_)).Times(0);
+    _ioStream.clearOutput();
+    _ioStream.queueInput("/admin/status\n");
+    _service->service();
+    EXPECT_THAT(_ioStream.getOutput(), testing::HasSubstr("Access Denied Test"));
+  }
+
   TEST_F(CLIServiceTest, CommandHistoryBasic)
   {
     _service->activate();
@@ -498,4 +522,221 @@ namespace cliService
     _service->service();
   }
 
+  // Command Metrics Tests
+
+  TEST_F(CLIServiceTest, CommandMetricsRecordLatencyAndErrors)
+  {
+    _service->activate();
+    _ioStream.queueInput("user:user123\n");
+    _service->service();
+
+    EXPECT_CALL(*_publicCmd, execute(testing::_))
+        .WillOnce(testing::DoAll(
+          testing::InvokeWithoutArgs([this]() { _clock.advance_us(300); }),
+          testing::Return(CLIResponse::success(std::string("ok")))))
+        .WillOnce(testing::DoAll(
+          testing::InvokeWithoutArgs([this]() { _clock.advance_us(5000); }),
+          testing::Return(CLIResponse::error(std::string("failed")))));
+
+    _ioStream.queueInput("public/info\n");
+    _service->service();
+    _ioStream.queueInput("public/info arg\n");
+    _service->service();
+
+    auto snapshot = _service->getMetricsSnapshot();
+    ASSERT_EQ(snapshot.size(), 1u);
+    EXPECT_EQ(snapshot[0].path, "/public/info");
+
+    const auto& metrics = snapshot[0].metrics;
+    EXPECT_EQ(metrics.getInvocations(), 2u);
+    EXPECT_EQ(metrics.getErrors(), 1u);
+    EXPECT_EQ(metrics.getTotalLatency_us(), 5300u);
+    EXPECT_EQ(metrics.getMaxLatency_us(), 5000u);
+    EXPECT_EQ(metrics.getBucketCount(CommandMetrics::getBucketIndex(300)), 1u);
+    EXPECT_EQ(metrics.getBucketCount(CommandMetrics::getBucketIndex(5000)), 1u);
+
+    // Navigation and global commands are not commands of the tree
+    _ioStream.queueInput("public\n");
+    _service->service();
+    _ioStream.queueInput("help\n");
+    _service->service();
+    EXPECT_EQ(_service->getMetricsSnapshot().size(), 1u);
+  }
+
+  TEST_F(CLIServiceTest, StatsCommandListsAccessibleCommands)
+  {
+    _service->activate();
+    _ioStream.queueInput("admin:admin123\n");
+    _service->service();
+
+    EXPECT_CALL(*_publicCmd, execute(testing::_))
+        .WillOnce(testing::Return(CLIResponse::success(std::string("ok"))));
+    EXPECT_CALL(*_adminCmd, execute(testing::_))
+        .WillOnce(testing::Return(CLIResponse::success(std::string("ok"))));
+
+    _ioStream.queueInput("public/info\n");
+    _service->service();
+    _ioStream.queueInput("/admin/config\n");
+    _service->service();
+
+    _ioStream.clearOutput();
+    _ioStream.queueInput("stats\n");
+    _service->service();
+    EXPECT_THAT(_ioStream.getOutput(), testing::HasSubstr("calls"));
+    EXPECT_THAT(_ioStream.getOutput(), testing::HasSubstr("/public/info"));
+    EXPECT_THAT(_ioStream.getOutput(), testing::HasSubstr("/admin/config"));
+
+    _ioStream.queueInput("logout\n");
+    _service->service();
+    _ioStream.queueInput("user:user123\n");
+    _service->service();
+
+    _ioStream.clearOutput();
+    _ioStream.queueInput("stats\n");
+    _service->service();
+    EXPECT_THAT(_ioStream.getOutput(), testing::HasSubstr("/public/info"));
+    EXPECT_THAT(_ioStream.getOutput(), testing::Not(testing::HasSubstr("/admin/config")));
+
+    // Users only reset the commands they can access, admin counters survive
+    _ioStream.clearOutput();
+    _ioStream.queueInput("stats reset\n");
+    _service->service();
+    ASSERT_EQ(_service->getMetricsSnapshot().size(), 1u);
+    EXPECT_EQ(_service->getMetricsSnapshot().front().path, "/admin/config");
+
+    _ioStream.clearOutput();
+    _ioStream.queueInput("stats\n");
+    _service->service();
+    EXPECT_THAT(_ioStream.getOutput(), testing::HasSubstr("No commands executed yet"));
+
+    _ioStream.queueInput("logout\n");
+    _service->service();
+    _ioStream.queueInput("admin:admin123\n");
+    _service->service();
+    _ioStream.queueInput("stats reset\n");
+    _service->service();
+    EXPECT_TRUE(_service->getMetricsSnapshot().empty());
+
+    _ioStream.clearOutput();
+    _ioStream.queueInput("stats bogus\n");
+    _service->service();
+    EXPECT_THAT(_ioStream.getOutput(), testing::HasSubstr("Usage: stats [reset]"));
+  }
+
+  // Tree Command Tests
+
+  TEST_F(CLIServiceTest, TreeOfSubtreeWithDepthLimit)
+  {
+    _service->activate();
+    _ioStream.queueInput("user:user123\n");
+    _service->service();
+
+    _ioStream.clearOutput();
+    _ioStream.queueInput("tree public\n");
+    _service->service();
+    EXPECT_THAT(_ioStream.getOutput(), testing::HasSubstr("  public/\r\n    info\r\n    nested/\r\n      test\r\n"));
+    EXPECT_THAT(_ioStream.getOutput(), testing::Not(testing::HasSubstr("root/")));
+
+    _ioStream.clearOutput();
+    _ioStream.queueInput("tree /public -L 1\n");
+    _service->service();
+    EXPECT_THAT(_ioStream.getOutput(), testing::HasSubstr("nested/"));
+    EXPECT_THAT(_ioStream.getOutput(), testing::Not(testing::HasSubstr("test")));
+
+    _ioStream.clearOutput();
+    _ioStream.queueInput("tree -L 0\n");
+    _service->service();
+    EXPECT_THAT(_ioStream.getOutput(), testing::HasSubstr("root/"));
+    EXPECT_THAT(_ioStream.getOutput(), testing::Not(testing::HasSubstr("public/")));
+
+    // Relative to the current directory
+    _ioStream.queueInput("public\n");
+    _service->service();
+    _ioStream.clearOutput();
+    _ioStream.queueInput("tree -L 1 nested\n");
+    _service->service();
+    EXPECT_THAT(_ioStream.getOutput(), testing::HasSubstr("  nested/\r\n    test\r\n"));
+  }
+
+  TEST_F(CLIServiceTest, OutputFilters)
+  {
+    ON_CALL(*_publicCmd, execute(testing::_)).WillByDefault(testing::Return(
+      CLIResponse::success(std::string("alpha\r\nbeta\r\ngamma"))));
+
+    _service->activate();
+    _ioStream.queueInput("user:user123\n");
+    _service->service();
+
+    _ioStream.clearOutput();
+    _ioStream.queueInput("public/info | grep a | tail 2\n");
+    _service->service();
+    EXPECT_THAT(_ioStream.getOutput(), testing::HasSubstr("\r\n  beta\r\n  gamma\r\n"));
+    EXPECT_THAT(_ioStream.getOutput(), testing::Not(testing::HasSubstr("alpha")));
+
+    _ioStream.clearOutput();
+    _ioStream.queueInput("tree | grep nested\n");
+    _service->service();
+    EXPECT_THAT(_ioStream.getOutput(), testing::HasSubstr("\r\n      nested/\r\n\r\nuser@/> "));
+    EXPECT_THAT(_ioStream.getOutput(), testing::Not(testing::HasSubstr("info")));
+
+    _ioStream.clearOutput();
+    _ioStream.queueInput("tree | count\n");
+    _service->service();
+    EXPECT_THAT(_ioStream.getOutput(), testing::HasSubstr("  5\r\n"));
+  }
+
+  TEST_F(CLIServiceTest, OutputFilterErrors)
+  {
+    EXPECT_CALL(*_publicCmd, execute(testing::_)).Times(0);
+
+    _service->activate();
+    _ioStream.queueInput("user:user123\n");
+    _service->service();
+
+    const std::vector<std::pair<std::string, std::string>> cases = {
+      {"public/info | sort\n", "Usage: <command> | grep"},
+      {"public/info | head x\n", "Usage: <command> | grep"},
+      {"public/info |\n", "Usage: <command> | grep"},
+      {"| count\n", "Usage: <command> | grep"},
+      {"public | count\n", "Only command output can be filtered"},
+      {"missing | count\n", "Invalid Path Test"}
+    };
+
+    for (const auto& [input, expected] : cases)
+    {
+      _ioStream.clearOutput();
+      _ioStream.queueInput(input);
+      _service->service();
+      EXPECT_THAT(_ioStream.getOutput(), testing::HasSubstr(expected)) << input;
+    }
+
+    EXPECT_THAT(_ioStream.getOutput(), testing::EndsWith("user@/> "));
+  }
+
+  TEST_F(CLIServiceTest, TreeArgumentErrors)
+  {
+    _service->activate();
+    _ioStream.queueInput("user:user123\n");
+    _service->service();
+
+    const std::vector<std::pair<std::string, std::string>> cases = {
+      {"tree missing\n", "Invalid Path Test"},
+      {"tree admin\n", "Access Denied Test"},
+      {"tree public/info\n", "Not a directory: public/info"},
+      {"tree -L\n", "Usage: tree [path] [-L depth]"},
+      {"tree -L x\n", "Usage: tree [path] [-L depth]"},
+      {"tree -L 99999\n", "Usage: tree [path] [-L depth]"},
+      {"tree public nested\n", "Usage: tree [path] [-L depth]"},
+      {"tree -x\n", "Usage: tree [path] [-L depth]"}
+    };
+
+    for (const auto& [input, expected] : cases)
+    {
+      _ioStream.clearOutput();
+      _ioStream.queueInput(input);
+      _service->service();
+      EXPECT_THAT(_ioStream.getOutput(), testing::HasSubstr(expected)) << input;
+    }
+  }
+
 }
@@ -79,6 +79,39 @@ namespace cliService
     EXPECT_EQ(commandRequest->getArgs()[1], "arg2");
   }
 
+  TEST_F(InputParserTest, CommandWithFilters)
+  {
+    auto parsed = InputParser::parseToPathAndArgs("hw/dump -a  | grep rgb led|head 3 |");
+
+    EXPECT_EQ(parsed.path.toString(), "hw/dump");
+    EXPECT_EQ(parsed.args, std::vector<std::string>{"-a"});
+
+    ASSERT_EQ(parsed.filters.size(), 3u);
+    EXPECT_EQ(parsed.filters[0], (std::vector<std::string>{"grep", "rgb", "led"}));
+    EXPECT_EQ(parsed.filters[1], (std::vector<std::string>{"head", "3"}));
+    EXPECT_TRUE(parsed.filters[2].empty());
+
+    auto request = InputParser::parseToCommandRequest("tree|count");
+    EXPECT_EQ(request->getPath().toString(), "tree");
+    EXPECT_TRUE(request->getArgs().empty());
+    EXPECT_EQ(request->getFilters().size(), 1u);
+    EXPECT_EQ(request->getOriginalInput(), "tree|count");
+  }
+
+  TEST_F(InputParserTest, BackgroundCommand)
+  {
+    auto request = InputParser::parseToCommandRequest("hw/dump 5 | head 2 & ");
+    EXPECT_TRUE(request->isBackground());
+    EXPECT_EQ(request->getArgs(), std::vector<std::string>{"5"});
+    EXPECT_EQ(request->getFilters(), (CommandRequest::Filters{{"head", "2"}}));
+
+    request = InputParser::parseToCommandRequest("hw/dump&");
+    EXPECT_TRUE(request->isBackground());
+    EXPECT_EQ(request->getPath().toString(), "hw/dump");
+
+    EXPECT_FALSE(InputParser::parseToCommandRequest("hw/dump a&b")->isBackground());
+  }
+
   TEST_F(InputParserTest, TabCompletion)
   {
     _ioStream.queueInput("command");
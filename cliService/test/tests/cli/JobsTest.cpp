@@ -0,0 +1,317 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "cliService/cli/CLIService.hpp"
+#include "cliService/cli/JobTable.hpp"
+#include "mock/command/CommandMock.hpp"
+#include "mock/io/CharIOStreamMock.hpp"
+
+namespace cliService
+{
+
+  // "line 1" ... "line N", tracking how far it was pulled
+  static std::shared_ptr<OutputSourceIf> numberedLines(size_t count, size_t& pulled)
+  {
+    pulled = 0;
+    return std::make_shared<CallbackOutputSource>([count, &pulled](std::string& line) {
+      if (pulled == count) { return false; }
+      line = "line " + std::to_string(++pulled);
+      return true;
+    });
+  }
+
+  static std::vector<std::string> drain(OutputSourceIf& source)
+  {
+    std::vector<std::string> lines;
+    std::string line;
+
+    while (source.nextLine(line)) {
+      lines.push_back(line);
+    }
+
+    return lines;
+  }
+
+  TEST(JobTableTest, JobsAdvanceInSteps)
+  {
+    JobTable jobs(1024);
+    size_t pulled = 0;
+
+    BackgroundJob* job = jobs.start("dump", CLIResponse::Status::Success, numberedLines(5, pulled));
+    ASSERT_NE(job, nullptr);
+    EXPECT_EQ(job->getId(), 1u);
+
+    jobs.service(2);
+    EXPECT_EQ(pulled, 2u);
+    EXPECT_TRUE(jobs.isRunning());
+
+    jobs.service(2);
+    jobs.service(2);
+    EXPECT_EQ(job->getBufferedLines(), 5u);
+    EXPECT_FALSE(jobs.isRunning());
+  }
+
+  TEST(JobTableTest, BufferDropsOldestLines)
+  {
+    JobTable jobs(24);  // Room for three 6 byte lines and their line breaks
+    size_t pulled = 0;
+
+    BackgroundJob* job = jobs.start("dump", CLIResponse::Status::Success, numberedLines(5, pulled));
+    jobs.service(10);
+
+    EXPECT_EQ(job->getBufferedLines(), 3u);
+    EXPECT_EQ(job->getBufferedBytes(), 24u);
+    EXPECT_EQ(job->getDroppedLines(), 2u);
+
+    auto output = job->takeOutput();
+    EXPECT_EQ(drain(*output), (std::vector<std::string>{"(2 earlier lines dropped)", "line 3", "line 4", "line 5"}));
+  }
+
+  TEST(JobTableTest, TakingOutputOfRunningJobContinuesIt)
+  {
+    JobTable jobs(1024);
+    size_t pulled = 0;
+
+    BackgroundJob* job = jobs.start("dump", CLIResponse::Status::Success, numberedLines(4, pulled));
+    jobs.service(1);
+
+    auto output = job->takeOutput();
+    EXPECT_FALSE(job->isRunning());
+    EXPECT_EQ(drain(*output), (std::vector<std::string>{"line 1", "line 2", "line 3", "line 4"}));
+  }
+
+  TEST(JobTableTest, LimitedNumberOfJobs)
+  {
+    JobTable jobs(1024);
+    size_t pulled = 0;
+
+    for (size_t i = 0; i < JobTable::MAX_JOBS; ++i) {
+      EXPECT_NE(jobs.start("job", CLIResponse::Status::Success, numberedLines(0, pulled)), nullptr);
+    }
+
+    EXPECT_EQ(jobs.start("job", CLIResponse::Status::Success, nullptr), nullptr);
+
+    // IDs continue after the highest one in use
+    jobs.remove(2);
+    EXPECT_EQ(jobs.start("job", CLIResponse::Status::Success, nullptr)->getId(), JobTable::MAX_JOBS + 1);
+    EXPECT_EQ(jobs.find(2), nullptr);
+  }
+
+
+  TEST(JobTableTest, EmptyLinesFillTheBufferToo)
+  {
+    auto emptyLines = [] {
+      return std::make_shared<CallbackOutputSource>([](std::string& line) {
+        line.clear();
+        return true;
+      });
+    };
+
+    JobTable jobs(1024);
+    BackgroundJob* job = jobs.start("yes ''", CLIResponse::Status::Success, emptyLines());
+
+    for (int i = 0; i < 100; ++i) { jobs.service(100); }
+
+    EXPECT_TRUE(job->isRunning());
+    EXPECT_EQ(job->getBufferedLines(), BackgroundJob::MAX_LINES);
+    EXPECT_LE(job->getBufferedBytes(), 1024u);
+    EXPECT_EQ(job->getDroppedLines(), 100 * 100 - BackgroundJob::MAX_LINES);
+
+    // Without any room every line is cut to nothing, still only one is kept
+    JobTable unbuffered(0);
+    job = unbuffered.start("yes", CLIResponse::Status::Success, emptyLines());
+    unbuffered.service(1000);
+    EXPECT_EQ(job->getBufferedLines(), 1u);
+  }
+
+
+  class JobsTest : public ::testing::Test
+  {
+  protected:
+    void SetUp() override
+    {
+      auto root = std::make_unique<Directory>("root", AccessLevel::User);
+      auto& hw = root->addDynamicDirectory("hw", AccessLevel::User);
+      _dumpCmd = &hw.addDynamicCommand<CommandMock>("dump", AccessLevel::User);
+      _failCmd = &root->addDynamicCommand<CommandMock>("fail", AccessLevel::User);
+      root->addDynamicCommand<CommandMock>("secret", AccessLevel::Admin);
+
+      // A header in the message, then lazily produced lines
+      ON_CALL(*_dumpCmd, execute(testing::_)).WillByDefault([this](const std::vector<std::string>& args) {
+        CLIResponse response = CLIResponse::success(std::string("dump"));
+        response.setOutputSource(numberedLines(args.empty() ? 20 : std::stoul(args[0]), _pulled));
+        return response;
+      });
+      ON_CALL(*_failCmd, execute(testing::_)).WillByDefault(testing::Return(CLIResponse::error(std::string("failed"))));
+
+      CLIServiceConfiguration config{_ioStream, {{"user", "user123", AccessLevel::User}, {"guest", "guest123", AccessLevel::User}},
+                                     std::move(root), 1000, 10};
+      _service = std::make_unique<CLIService>(std::move(config));
+
+      _service->activate();
+      send("user:user123\n");
+      _ioStream.clearOutput();
+    }
+
+    void send(const std::string& input)
+    {
+      _ioStream.queueInput(input);
+      _service->service();
+    }
+
+    CharIOStreamMock _ioStream;
+    CommandMock* _dumpCmd;
+    CommandMock* _failCmd;
+    size_t _pulled = 0;
+    std::unique_ptr<CLIService> _service;
+  };
+
+  TEST_F(JobsTest, PromptReturnsWhileJobRuns)
+  {
+    send("hw/dump 20 &\n");
+    EXPECT_THAT(_ioStream.getOutput(), testing::HasSubstr("[1] hw/dump 20\r\n\r\nuser@/> "));
+
+    // Output is produced by later service() calls, not shown
+    const size_t pulledAtStart = _pulled;
+    _ioStream.clearOutput();
+    _service->service();
+    EXPECT_GT(_pulled, pulledAtStart);
+    EXPECT_LT(_pulled, 20u);
+    EXPECT_EQ(_ioStream.getOutput(), "");
+
+    send("jobs\n");
+    EXPECT_THAT(_ioStream.getOutput(), testing::HasSubstr("[1] Running  hw/dump 20  ("));
+
+    for (int i = 0; i < 5; ++i) { _service->service(); }
+
+    _ioStream.clearOutput();
+    send("jobs\n");
+    EXPECT_THAT(_ioStream.getOutput(), testing::HasSubstr("[1] Done     hw/dump 20  (21 lines)"));
+
+    _ioStream.clearOutput();
+    send("fg\n");
+    const std::string output = _ioStream.getOutput();
+    EXPECT_THAT(output, testing::HasSubstr("  dump\r\n  line 1\r\n"));
+    EXPECT_THAT(output, testing::HasSubstr("  line 20\r\n\r\nuser@/> "));
+
+    _ioStream.clearOutput();
+    send("jobs\n");
+    EXPECT_THAT(_ioStream.getOutput(), testing::HasSubstr("No jobs"));
+  }
+
+  TEST_F(JobsTest, CommandRunsAfterThePromptIsBack)
+  {
+    EXPECT_CALL(*_dumpCmd, execute(testing::_)).Times(0);
+    send("hw/dump 3 &\n");
+    EXPECT_THAT(_ioStream.getOutput(), testing::EndsWith("user@/> "));
+    testing::Mock::VerifyAndClearExpectations(_dumpCmd);
+
+    // The job's first turn in the service loop runs it
+    EXPECT_CALL(*_dumpCmd, execute(testing::_)).Times(1);
+    _service->service();
+
+    _ioStream.clearOutput();
+    send("jobs\n");
+    EXPECT_THAT(_ioStream.getOutput(), testing::HasSubstr("[1] Done     hw/dump 3  (4 lines)"));
+  }
+
+  TEST_F(JobsTest, FgStartsAJobNotRunYet)
+  {
+    send("hw/dump 2 &\nfg\n");
+
+    EXPECT_THAT(_ioStream.getOutput(), testing::HasSubstr("  dump\r\n  line 1\r\n  line 2\r\n\r\nuser@/> "));
+  }
+
+  TEST_F(JobsTest, FgOfRunningJobFinishesInForeground)
+  {
+    send("hw/dump 100 | grep 7 &\n");
+    send("fail&\n");
+
+    _ioStream.clearOutput();
+    send("fg 1\n");
+    EXPECT_THAT(_ioStream.getOutput(), testing::HasSubstr("  line 97\r\n\r\nuser@/> "));
+    EXPECT_THAT(_ioStream.getOutput(), testing::Not(testing::HasSubstr("line 98")));
+    EXPECT_EQ(_pulled, 100u);
+
+    _ioStream.clearOutput();
+    send("jobs\n");
+    EXPECT_THAT(_ioStream.getOutput(), testing::HasSubstr("[2] Failed   fail  (1 lines)"));
+  }
+
+  TEST_F(JobsTest, ChattyJobKeepsOnlyTheNewestOutput)
+  {
+    send("hw/dump 1000 &\n");
+    for (int i = 0; i < 200; ++i) { _service->service(); }
+
+    _ioStream.clearOutput();
+    send("fg 1\n");
+
+    const std::string output = _ioStream.getOutput();
+    EXPECT_THAT(output, testing::HasSubstr("earlier lines dropped)"));
+    EXPECT_THAT(output, testing::HasSubstr("line 1000\r\n"));
+    EXPECT_LT(output.length(), 2 * 1024u);  // Buffered bytes plus indentation and line breaks
+  }
+
+  TEST_F(JobsTest, Errors)
+  {
+    EXPECT_CALL(*_dumpCmd, execute(testing::_)).Times(JobTable::MAX_JOBS);
+
+    const std::vector<std::pair<std::string, std::string>> cases = {
+      {"&\n", "Only commands in the tree can run in the background"},
+      {"tree &\n", "Only commands in the tree can run in the background"},
+      {"hw &\n", "Not a command: hw"},
+      {"missing &\n", std::string(CLIMessages::getDefaults().getInvalidPathMessage())},
+      {"secret &\n", std::string(CLIMessages::getDefaults().getAccessDeniedMessage())},
+      {"fg\n", "No such job"},
+      {"fg 7\n", "No such job"},
+      {"fg x\n", "Usage: fg [N]"},
+      {"jobs 1\n", std::string(CLIMessages::getDefaults().getNoArgumentsMessage())}
+    };
+
+    for (const auto& [input, expected] : cases)
+    {
+      _ioStream.clearOutput();
+      send(input);
+      EXPECT_THAT(_ioStream.getOutput(), testing::HasSubstr(expected)) << input;
+    }
+
+    for (size_t i = 0; i < JobTable::MAX_JOBS; ++i) {
+      send("hw/dump &\n");
+    }
+
+    _ioStream.clearOutput();
+    send("hw/dump &\n");
+    EXPECT_THAT(_ioStream.getOutput(), testing::HasSubstr("Too many jobs"));
+  }
+
+  TEST_F(JobsTest, LogoutDropsJobs)
+  {
+    send("hw/dump &\n");
+    send("logout\n");
+    send("user:user123\n");
+
+    _ioStream.clearOutput();
+    send("jobs\n");
+    EXPECT_THAT(_ioStream.getOutput(), testing::HasSubstr("No jobs"));
+  }
+
+  TEST_F(JobsTest, ExitDropsJobs)
+  {
+    send("hw/dump 5 &\n");
+    send("exit\n");
+    EXPECT_EQ(_service->getCLIState(), CLIState::Inactive);
+
+    // The next session on the stream sees nothing of the previous user's jobs
+    _service->activate();
+    send("guest:guest123\n");
+
+    _ioStream.clearOutput();
+    send("fg\n");
+    EXPECT_THAT(_ioStream.getOutput(), testing::HasSubstr("No such job"));
+    EXPECT_THAT(_ioStream.getOutput(), testing::Not(testing::HasSubstr("dump")));
+
+    _ioStream.clearOutput();
+    send("jobs\n");
+    EXPECT_THAT(_ioStream.getOutput(), testing::HasSubstr("No jobs"));
+  }
+
+}
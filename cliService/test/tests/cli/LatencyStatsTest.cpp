@@ -0,0 +1,132 @@
+#include "gtest/gtest.h"
+#include "cliService/cli/CLIService.hpp"
+#include "cliService/cli/LatencyStats.hpp"
+#include "mock/clock/ClockMock.hpp"
+#include "mock/command/CommandMock.hpp"
+#include "mock/io/CharIOStreamMock.hpp"
+
+namespace cliService
+{
+
+  TEST(LatencyStatsTest, AggregatesPerKind)
+  {
+    LatencyStats stats;
+    stats.record(LatencyStats::Kind::CharEcho, 10);
+    stats.record(LatencyStats::Kind::CharEcho, 30);
+    stats.record(LatencyStats::Kind::Command, 2000);
+
+    const auto& echo = stats.get(LatencyStats::Kind::CharEcho);
+    EXPECT_EQ(echo.getInvocations(), 2u);
+    EXPECT_EQ(echo.getMaxLatency_us(), 30u);
+    EXPECT_EQ(echo.getPercentileLatency_us(50), 15u);
+    EXPECT_EQ(echo.getPercentileLatency_us(99), 30u);
+
+    EXPECT_EQ(stats.get(LatencyStats::Kind::Command).getInvocations(), 1u);
+    EXPECT_EQ(stats.get(LatencyStats::Kind::Tab).getInvocations(), 0u);
+    EXPECT_EQ(stats.get(LatencyStats::Kind::History).getPercentileLatency_us(99), 0u);
+
+    stats.reset();
+    EXPECT_EQ(stats.get(LatencyStats::Kind::CharEcho).getInvocations(), 0u);
+  }
+
+  TEST(LatencyStatsTest, KindNames)
+  {
+    EXPECT_STREQ(LatencyStats::getName(LatencyStats::Kind::CharEcho), "echo");
+    EXPECT_STREQ(LatencyStats::getName(LatencyStats::Kind::Tab), "tab");
+    EXPECT_STREQ(LatencyStats::getName(LatencyStats::Kind::History), "history");
+    EXPECT_STREQ(LatencyStats::getName(LatencyStats::Kind::Command), "command");
+  }
+
+#if CLISERVICE_LATENCY_STATS
+
+  // Every byte written takes 10 us, standing in for a slow link
+  class SlowCharIOStreamMock : public CharIOStreamMock
+  {
+  public:
+    explicit SlowCharIOStreamMock(ClockMock& clock) : _clock(clock) {}
+
+    bool putChar(char c) override
+    {
+      _clock.advance_us(10);
+      return CharIOStreamMock::putChar(c);
+    }
+
+  private:
+    ClockMock& _clock;
+  };
+
+  class LatencyInstrumentationTest : public ::testing::Test
+  {
+  protected:
+    void SetUp() override
+    {
+      auto root = std::make_unique<Directory>("root", AccessLevel::User);
+      auto& system = root->addDynamicDirectory("system", AccessLevel::User);
+      _cmd = &system.addDynamicCommand<CommandMock>("status", AccessLevel::User);
+
+      CLIServiceConfiguration config{_ioStream, {{"user", "user123", AccessLevel::User}}, std::move(root), 1000, 10};
+      config._clock = &_clock;
+      _service = std::make_unique<CLIService>(std::move(config));
+
+      _service->activate();
+      send("user:user123\n");
+      _service->resetLatencyStats();
+    }
+
+    void send(const std::string& input)
+    {
+      _ioStream.queueInput(input);
+      while (_ioStream.available()) {
+        _service->service();
+      }
+    }
+
+    const CommandMetrics& get(LatencyStats::Kind kind) const { return _service->getLatencyStats().get(kind); }
+
+    ClockMock _clock;
+    SlowCharIOStreamMock _ioStream{_clock};
+    CommandMock* _cmd;
+    std::unique_ptr<CLIService> _service;
+  };
+
+  TEST_F(LatencyInstrumentationTest, CharEchoIsTimedPerByte)
+  {
+    send("sys");
+
+    EXPECT_EQ(get(LatencyStats::Kind::CharEcho).getInvocations(), 3u);
+    EXPECT_EQ(get(LatencyStats::Kind::CharEcho).getMaxLatency_us(), 10u);
+  }
+
+  TEST_F(LatencyInstrumentationTest, RequestsAreTimedUntilResponseIsWritten)
+  {
+    EXPECT_CALL(*_cmd, execute(testing::_))
+        .WillOnce(testing::DoAll(
+          testing::InvokeWithoutArgs([this]() { _clock.advance_us(1000); }),
+          testing::Return(CLIResponse::success(std::string("ok")))));
+
+    send("system/status\n");
+    const auto& command = get(LatencyStats::Kind::Command);
+    EXPECT_EQ(command.getInvocations(), 1u);
+    EXPECT_GT(command.getMaxLatency_us(), 1000u);
+
+    send("system/st\t");
+    EXPECT_EQ(get(LatencyStats::Kind::Tab).getInvocations(), 1u);
+
+    send("\x1b[A");
+    EXPECT_EQ(get(LatencyStats::Kind::History).getInvocations(), 1u);
+    EXPECT_GT(get(LatencyStats::Kind::History).getMaxLatency_us(), 0u);
+  }
+
+  TEST_F(LatencyInstrumentationTest, StatsCommandShowsLatencies)
+  {
+    send("sys");
+    _ioStream.clearOutput();
+    send("\x7f\x7f\x7fstats\n");
+
+    EXPECT_THAT(_ioStream.getOutput(), testing::HasSubstr("input"));
+    EXPECT_THAT(_ioStream.getOutput(), testing::HasSubstr("echo"));
+  }
+
+#endif
+
+}
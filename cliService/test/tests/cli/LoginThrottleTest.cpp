@@ -0,0 +1,240 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "cliService/cli/CLIService.hpp"
+#include "cliService/cli/LoginThrottle.hpp"
+#include "mock/clock/ClockMock.hpp"
+#include "mock/command/CommandMock.hpp"
+#include "mock/io/CharIOStreamMock.hpp"
+
+namespace cliService
+{
+
+  TEST(LoginThrottleTest, DelaySchedule)
+  {
+    LoginThrottle throttle(1000, 8000);
+
+    for (uint32_t failures = 0; failures <= LoginThrottle::FREE_FAILURES; ++failures) {
+      EXPECT_EQ(throttle.getDelay_us(failures), 0u);
+    }
+
+    EXPECT_EQ(throttle.getDelay_us(LoginThrottle::FREE_FAILURES + 1), 1000000u);
+    EXPECT_EQ(throttle.getDelay_us(LoginThrottle::FREE_FAILURES + 2), 2000000u);
+    EXPECT_EQ(throttle.getDelay_us(LoginThrottle::FREE_FAILURES + 4), 8000000u);
+    EXPECT_EQ(throttle.getDelay_us(LoginThrottle::FREE_FAILURES + 5), 8000000u);
+    EXPECT_EQ(throttle.getDelay_us(UINT32_MAX), 8000000u);
+
+    // A zero base delay turns throttling off
+    EXPECT_EQ(LoginThrottle(0).getDelay_us(100), 0u);
+  }
+
+  TEST(LoginThrottleTest, BackoffForgetsOldFailures)
+  {
+    LoginThrottle throttle(1000, 60000);
+    LoginThrottle::Backoff backoff;
+    uint64_t now_us = 0;
+
+    for (uint32_t i = 0; i < LoginThrottle::FREE_FAILURES; ++i) {
+      EXPECT_EQ(throttle.recordFailure(backoff, now_us), 0u);
+    }
+    EXPECT_FALSE(backoff.isWaiting(now_us));
+
+    EXPECT_EQ(throttle.recordFailure(backoff, now_us), 1000000u);
+    EXPECT_TRUE(backoff.isWaiting(now_us + 999999));
+    EXPECT_FALSE(backoff.isWaiting(now_us + 1000000));
+
+    now_us += LoginThrottle::FORGET_AFTER_US;
+    EXPECT_EQ(throttle.recordFailure(backoff, now_us), 0u);
+    EXPECT_EQ(backoff.failures, 1u);
+  }
+
+  TEST(LoginThrottleTest, UsernamesAreBounded)
+  {
+    LoginThrottle throttle(1000, 60000);
+
+    for (uint32_t i = 0; i <= LoginThrottle::FREE_FAILURES; ++i) {
+      throttle.recordFailure("admin", 0);
+    }
+    EXPECT_TRUE(throttle.isWaiting("admin", 0));
+    EXPECT_FALSE(throttle.isWaiting("user", 0));
+
+    // Flooding with fresh names evicts the oldest entry, never grows past the
+    // bound and never lifts a wait
+    for (size_t i = 0; i < 2 * LoginThrottle::MAX_TRACKED_USERNAMES; ++i) {
+      throttle.recordFailure("name" + std::to_string(i), 1 + i);
+    }
+    EXPECT_EQ(throttle.getTrackedUsernames(), LoginThrottle::MAX_TRACKED_USERNAMES);
+    EXPECT_TRUE(throttle.isWaiting("admin", 1000));
+
+    // Once its wait is over the entry is fair game
+    for (size_t i = 0; i < LoginThrottle::MAX_TRACKED_USERNAMES; ++i) {
+      throttle.recordFailure("late" + std::to_string(i), 1000000 + i);
+    }
+    EXPECT_EQ(throttle.getTrackedUsernames(), LoginThrottle::MAX_TRACKED_USERNAMES);
+    EXPECT_FALSE(throttle.isWaiting("admin", 0));
+
+    throttle.recordFailure("admin", 2000000);
+    throttle.recordSuccess("admin");
+    EXPECT_FALSE(throttle.isWaiting("admin", 2000000));
+  }
+
+  TEST(LoginThrottleTest, WaitingNamesAreKeptWhenFull)
+  {
+    LoginThrottle throttle(1000, 60000);
+
+    for (size_t i = 0; i < LoginThrottle::MAX_TRACKED_USERNAMES; ++i)
+    {
+      for (uint32_t failure = 0; failure <= LoginThrottle::FREE_FAILURES; ++failure) {
+        throttle.recordFailure("name" + std::to_string(i), 0);
+      }
+    }
+
+    // No slot to give, the new name goes untracked
+    for (uint32_t failure = 0; failure <= LoginThrottle::FREE_FAILURES; ++failure) {
+      EXPECT_EQ(throttle.recordFailure("admin", 0), 0u);
+    }
+    EXPECT_FALSE(throttle.isWaiting("admin", 0));
+    EXPECT_TRUE(throttle.isWaiting("name0", 0));
+    EXPECT_EQ(throttle.getTrackedUsernames(), LoginThrottle::MAX_TRACKED_USERNAMES);
+  }
+
+
+  class LoginThrottleServiceTest : public ::testing::Test
+  {
+  protected:
+    std::unique_ptr<CLIService> makeService(CharIOStreamMock& ioStream, LoginThrottle* sharedThrottle = nullptr)
+    {
+      CLIServiceConfiguration config{ioStream, {{"admin", "admin123", AccessLevel::Admin}}, _root, 1000, 10};
+      config._clock = &_clock;
+      config._passwordIterations = 1;
+      config._loginBackoff_ms = 1000;
+      config._maxLoginBackoff_ms = 4000;
+      config._loginThrottle = sharedThrottle;
+
+      auto service = std::make_unique<CLIService>(std::move(config));
+      service->activate();
+      return service;
+    }
+
+    void fail(CLIService& service, CharIOStreamMock& ioStream, const std::string& line, uint32_t count)
+    {
+      for (uint32_t i = 0; i < count; ++i)
+      {
+        ioStream.queueInput(line);
+        service.service();
+        ASSERT_FALSE(ioStream.available()) << "attempt " << i << " was held back";
+      }
+    }
+
+    ClockMock _clock;
+    Directory _root{"root", AccessLevel::User};
+  };
+
+  TEST_F(LoginThrottleServiceTest, SessionWaitsWithoutReadingInput)
+  {
+    CharIOStreamMock ioStream;
+    auto service = makeService(ioStream);
+
+    fail(*service, ioStream, "admin:wrong\n", LoginThrottle::FREE_FAILURES);
+    EXPECT_THAT(ioStream.getOutput(), testing::Not(testing::HasSubstr("Too many failed logins")));
+
+    // Malformed attempts count as well
+    fail(*service, ioStream, "garbage\n", 1);
+    EXPECT_THAT(ioStream.getOutput(), testing::HasSubstr("Too many failed logins, next attempt in 1 s"));
+
+    // The correct password waits in the stream until the deadline
+    ioStream.queueInput("admin:admin123\n");
+    service->service();
+    _clock.advance_ms(999);
+    service->service();
+    EXPECT_EQ(service->getCLIState(), CLIState::LoggedOut);
+    EXPECT_TRUE(ioStream.available());
+
+    _clock.advance_ms(1);
+    service->service();
+    EXPECT_EQ(service->getCLIState(), CLIState::LoggedIn);
+  }
+
+  TEST_F(LoginThrottleServiceTest, BackoffDoublesUpToTheCap)
+  {
+    CharIOStreamMock ioStream;
+    auto service = makeService(ioStream);
+
+    fail(*service, ioStream, "admin:wrong\n", LoginThrottle::FREE_FAILURES);
+
+    for (uint64_t expected_s : {1, 2, 4, 4})
+    {
+      ioStream.clearOutput();
+      fail(*service, ioStream, "admin:wrong\n", 1);
+      EXPECT_THAT(ioStream.getOutput(), testing::HasSubstr("next attempt in " + std::to_string(expected_s) + " s"));
+
+      // Pipelined attempts stay queued, one more wait short of the deadline
+      ioStream.queueInput("admin:wrong\n");
+      _clock.advance_ms(expected_s * 1000 - 1);
+      service->service();
+      EXPECT_TRUE(ioStream.available());
+
+      ioStream.flush();
+      _clock.advance_ms(1);
+    }
+  }
+
+  TEST_F(LoginThrottleServiceTest, UsernameThrottledAcrossSessions)
+  {
+    LoginThrottle shared(1000, 4000);
+
+    CharIOStreamMock attackerStream;
+    auto attacker = makeService(attackerStream, &shared);
+    fail(*attacker, attackerStream, "admin:guess\n", LoginThrottle::FREE_FAILURES + 1);
+    EXPECT_EQ(shared.getDeadline_us("admin"), 1000000u);
+
+    // A fresh session's guess at 'admin' is held until the name's wait is over
+    CharIOStreamMock otherStream;
+    auto other = makeService(otherStream, &shared);
+    otherStream.clearOutput();
+    otherStream.queueInput("admin:guess2\nadmin:guess3\n");
+    other->service();
+    _clock.advance_ms(999);
+    other->service();
+    EXPECT_THAT(otherStream.getOutput(), testing::Not(testing::HasSubstr(CLIMessages::getDefaults().getInvalidLoginMessage())));
+
+    _clock.advance_ms(1);
+    other->service();
+    EXPECT_THAT(otherStream.getOutput(), testing::HasSubstr("Too many failed logins, next attempt in 2 s"));
+    EXPECT_TRUE(otherStream.available());
+
+    // The right password waits as well, but is not locked out
+    CharIOStreamMock ownerStream;
+    auto owner = makeService(ownerStream, &shared);
+    ownerStream.queueInput("admin:admin123\n");
+    owner->service();
+    EXPECT_EQ(owner->getCLIState(), CLIState::LoggedOut);
+
+    // Further failures while it is held do not push it back
+    _clock.advance_ms(2000);
+    other->service();
+    EXPECT_GT(shared.getDeadline_us("admin"), _clock.now_us());
+
+    owner->service();
+    EXPECT_EQ(owner->getCLIState(), CLIState::LoggedIn);
+    EXPECT_FALSE(shared.isWaiting("admin", _clock.now_us()));
+  }
+
+  TEST_F(LoginThrottleServiceTest, SuccessResetsSession)
+  {
+    CharIOStreamMock ioStream;
+    auto service = makeService(ioStream);
+
+    fail(*service, ioStream, "admin:wrong\n", LoginThrottle::FREE_FAILURES);
+    ioStream.queueInput("admin:admin123\n");
+    service->service();
+    EXPECT_EQ(service->getCLIState(), CLIState::LoggedIn);
+
+    ioStream.queueInput("logout\n");
+    service->service();
+    ioStream.clearOutput();
+
+    fail(*service, ioStream, "admin:wrong\n", LoginThrottle::FREE_FAILURES);
+    EXPECT_THAT(ioStream.getOutput(), testing::Not(testing::HasSubstr("Too many failed logins")));
+  }
+
+}
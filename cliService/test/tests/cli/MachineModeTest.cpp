@@ -0,0 +1,225 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "cliService/cli/CLIService.hpp"
+#include "mock/command/CommandMock.hpp"
+#include "mock/io/CharIOStreamMock.hpp"
+
+namespace cliService
+{
+
+  class MachineModeTest : public ::testing::Test
+  {
+  protected:
+    struct Frame
+    {
+      int status;
+      std::string body;
+    };
+
+    void SetUp() override
+    {
+      auto root = std::make_unique<Directory>("root", AccessLevel::User);
+      auto& echoCmd = root->addDynamicCommand<CommandMock>("echo", AccessLevel::User);
+      auto& failCmd = root->addDynamicCommand<CommandMock>("fail", AccessLevel::User);
+      root->addDynamicDirectory("admin", AccessLevel::Admin);
+
+      ON_CALL(echoCmd, execute(testing::_)).WillByDefault([](const std::vector<std::string>& args) {
+        return CLIResponse::success(args.empty() ? std::string("none") : args.front());
+      });
+      ON_CALL(failCmd, execute(testing::_)).WillByDefault(testing::Return(CLIResponse::error(std::string("failed\r\nbadly"))));
+
+      // An optional message line, then an empty line and "a"
+      auto& streamCmd = root->addDynamicCommand<CommandMock>("stream", AccessLevel::User);
+      ON_CALL(streamCmd, execute(testing::_)).WillByDefault([](const std::vector<std::string>& args) {
+        CLIResponse response = CLIResponse::success(args.empty() ? std::string() : args.front() + "\r\n");
+        auto lines = std::make_shared<std::vector<std::string>>(std::vector<std::string>{"", "a"});
+        response.setOutputSource(std::make_shared<CallbackOutputSource>([lines](std::string& line) {
+          if (lines->empty()) { return false; }
+          line = lines->front();
+          lines->erase(lines->begin());
+          return true;
+        }));
+        return response;
+      });
+
+      _root = std::move(root);
+    }
+
+    void createService(bool machineMode, size_t maxRequestsPerService = 16)
+    {
+      CLIServiceConfiguration config{_ioStream, {{"user", "user123", AccessLevel::User}}, std::move(_root), 1000, 10};
+      config._machineMode = machineMode;
+      config._maxRequestsPerService = maxRequestsPerService;
+      _service = std::make_unique<CLIService>(std::move(config));
+      _service->activate();
+    }
+
+    void send(const std::string& input)
+    {
+      _ioStream.queueInput(input);
+      while (_ioStream.available()) {
+        _service->service();
+      }
+    }
+
+    // Split the output into frames, failing on anything in between
+    std::vector<Frame> frames() const
+    {
+      std::vector<Frame> result;
+      const std::string output = _ioStream.getOutput();
+      size_t pos = 0;
+
+      while (pos < output.length())
+      {
+        const size_t headerEnd = output.find("\r\n", pos);
+        if (headerEnd == std::string::npos) { ADD_FAILURE() << "Incomplete header"; break; }
+
+        int status = -1;
+        size_t length = 0;
+
+        if (std::sscanf(output.substr(pos, headerEnd - pos).c_str(), "%d %zu", &status, &length) != 2) {
+          ADD_FAILURE() << "Malformed header at " << pos;
+          break;
+        }
+
+        result.push_back({status, output.substr(headerEnd + 2, length)});
+        pos = headerEnd + 2 + length;
+      }
+
+      return result;
+    }
+
+    std::unique_ptr<Directory> _root;
+    CharIOStreamMock _ioStream;
+    std::unique_ptr<CLIService> _service;
+  };
+
+  TEST_F(MachineModeTest, NoEchoPromptOrWelcome)
+  {
+    createService(true);
+    EXPECT_EQ(_ioStream.getOutput(), "");
+
+    send("user:user123\n");
+    auto result = frames();
+    ASSERT_EQ(result.size(), 1u);
+    EXPECT_EQ(result[0].status, 0);
+    EXPECT_EQ(result[0].body, CLIMessages::getDefaults().getLoggedInMessage());
+
+    // Backspace, Tab and arrow keys are neither echoed nor answered
+    _ioStream.clearOutput();
+    send("echp\b\t\x1b[A");
+    EXPECT_EQ(_ioStream.getOutput(), "");
+
+    send("o hello\n");
+    result = frames();
+    ASSERT_EQ(result.size(), 1u);
+    EXPECT_EQ(result[0].body, "hello");
+  }
+
+  TEST_F(MachineModeTest, PipelinedCommandsAnswerInOrder)
+  {
+    createService(true);
+    send("user:user123\n");
+    _ioStream.clearOutput();
+
+    send("echo 1\nfail\nmissing\nadmin\necho 2\n");
+
+    const auto result = frames();
+    ASSERT_EQ(result.size(), 5u);
+    EXPECT_EQ(result[0].status, static_cast<int>(CLIResponse::Status::Success));
+    EXPECT_EQ(result[0].body, "1");
+    EXPECT_EQ(result[1].status, static_cast<int>(CLIResponse::Status::Error));
+    EXPECT_EQ(result[1].body, "failed\r\nbadly");
+    EXPECT_EQ(result[2].status, static_cast<int>(CLIResponse::Status::InvalidPath));
+    EXPECT_EQ(result[3].status, static_cast<int>(CLIResponse::Status::AccessDenied));
+    EXPECT_EQ(result[4].body, "2");
+  }
+
+  TEST_F(MachineModeTest, BufferedLinesHandledInOneServiceCall)
+  {
+    createService(true, 3);
+    _ioStream.queueInput("user:user123\r\necho 1\r\necho 2\r\necho 3\r\necho 4\r\n");
+
+    _service->service();
+    auto result = frames();
+    ASSERT_EQ(result.size(), 3u);
+    EXPECT_EQ(result[1].body, "1");
+    EXPECT_EQ(result[2].body, "2");
+
+    // The rest waits for the next call, still in order
+    _ioStream.clearOutput();
+    _service->service();
+    result = frames();
+    ASSERT_EQ(result.size(), 2u);
+    EXPECT_EQ(result[0].body, "3");
+    EXPECT_EQ(result[1].body, "4");
+  }
+
+  TEST_F(MachineModeTest, PipelinedHumanResponsesEndWithPrompts)
+  {
+    createService(false);
+    send("user:user123\n");
+    _ioStream.clearOutput();
+
+    _ioStream.queueInput("echo a\necho b\n");
+    _service->service();
+
+    const std::string output = _ioStream.getOutput();
+    EXPECT_FALSE(_ioStream.available());
+    EXPECT_THAT(output, testing::ContainsRegex("echo a\r\n\r\n  a\r\n\r\nuser@/> echo b\r\n\r\n  b\r\n\r\nuser@/> $"));
+  }
+
+  TEST_F(MachineModeTest, StreamedOutputIsFramedWhole)
+  {
+    createService(true);
+    send("user:user123\n");
+    _ioStream.clearOutput();
+
+    send("tree\n");
+
+    const auto result = frames();
+    ASSERT_EQ(result.size(), 1u);
+    EXPECT_EQ(result[0].body, "root/\r\n  echo\r\n  fail\r\n  stream");
+  }
+
+  TEST_F(MachineModeTest, StreamedLinesKeepTheirBreaks)
+  {
+    createService(true);
+    send("user:user123\n");
+    _ioStream.clearOutput();
+
+    // Leading empty lines are kept, a message's own line break is not doubled
+    send("stream\n");
+    send("stream head\n");
+
+    const auto result = frames();
+    ASSERT_EQ(result.size(), 2u);
+    EXPECT_EQ(result[0].body, "\r\na");
+    EXPECT_EQ(result[1].body, "head\r\n\r\na");
+  }
+
+  TEST_F(MachineModeTest, SwitchedPerSession)
+  {
+    createService(false);
+    send("user:user123\n");
+    _ioStream.clearOutput();
+
+    send("mode machine\n");
+    EXPECT_EQ(_ioStream.getOutput(), "mode machine\r\n0 20\r\nOutput mode: machine");
+
+    _ioStream.clearOutput();
+    send("mode\n");
+    EXPECT_EQ(_ioStream.getOutput(), "0 7\r\nmachine");
+
+    // Back to human output, the response already has a prompt
+    _ioStream.clearOutput();
+    send("mode human\n");
+    EXPECT_THAT(_ioStream.getOutput(), testing::HasSubstr("  Output mode: human"));
+    EXPECT_THAT(_ioStream.getOutput(), testing::EndsWith("user@/> "));
+
+    _ioStream.clearOutput();
+    send("mode robot\n");
+    EXPECT_THAT(_ioStream.getOutput(), testing::HasSubstr("Usage: mode [human|machine|binary]"));
+  }
+
+}
@@ -0,0 +1,165 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "cliService/cli/CLIService.hpp"
+#include "mock/command/CommandMock.hpp"
+#include "mock/io/CharIOStreamMock.hpp"
+
+namespace cliService
+{
+
+  class PagerTest : public ::testing::Test
+  {
+  protected:
+    static constexpr size_t PAGE_HEIGHT = 3;
+    static constexpr int DUMP_LINES = 10;
+
+    void SetUp() override
+    {
+      auto root = std::make_unique<Directory>("root", AccessLevel::User);
+      _dumpCmd = &root->addDynamicCommand<CommandMock>("dump", AccessLevel::User);
+      _shortCmd = &root->addDynamicCommand<CommandMock>("short", AccessLevel::User);
+
+      // 'dump' streams DUMP_LINES lines and counts how many were pulled
+      ON_CALL(*_dumpCmd, execute(testing::_)).WillByDefault([this](const std::vector<std::string>&) {
+        auto source = std::make_shared<CallbackOutputSource>([this](std::string& line) {
+          if (_pulled == DUMP_LINES) { return false; }
+          line = "line" + std::to_string(_pulled++);
+          return true;
+        });
+        _source = source;
+
+        CLIResponse response = CLIResponse::success(std::string("header"));
+        response.setOutputSource(std::move(source));
+        return response;
+      });
+      ON_CALL(*_shortCmd, execute(testing::_)).WillByDefault(testing::Return(CLIResponse::success(std::string("a\r\nb"))));
+
+      CLIServiceConfiguration config{_ioStream, {{"user", "user123", AccessLevel::User}}, std::move(root), 1000, 10};
+      config._pageHeight = PAGE_HEIGHT;
+      _service = std::make_unique<CLIService>(std::move(config));
+
+      _service->activate();
+      send("user:user123\n");
+      _ioStream.clearOutput();
+    }
+
+    void send(const std::string& input)
+    {
+      _ioStream.queueInput(input);
+      while (_ioStream.available()) {
+        _service->service();
+      }
+    }
+
+    std::string more() const { return std::string(CLIMessages::getDefaults().getMorePrompt()); }
+
+    CharIOStreamMock _ioStream;
+    CommandMock* _dumpCmd;
+    CommandMock* _shortCmd;
+    std::unique_ptr<CLIService> _service;
+    int _pulled = 0;
+    std::weak_ptr<OutputSourceIf> _source;
+  };
+
+  TEST_F(PagerTest, FirstPageOnlyPullsOneScreen)
+  {
+    send("dump\n");
+
+    // Message line plus two source lines, and one line of lookahead
+    EXPECT_EQ(_pulled, 3);
+    EXPECT_THAT(_ioStream.getOutput(), testing::HasSubstr("  header\r\n  line0\r\n  line1\r\n" + more()));
+    EXPECT_THAT(_ioStream.getOutput(), testing::Not(testing::HasSubstr("line2")));
+    EXPECT_THAT(_ioStream.getOutput(), testing::Not(testing::HasSubstr("user@/>")));
+  }
+
+  TEST_F(PagerTest, SpaceShowsNextPageAndEnterOneLine)
+  {
+    send("dump\n");
+    _ioStream.clearOutput();
+
+    send(" ");
+    EXPECT_THAT(_ioStream.getOutput(), testing::HasSubstr("line2\r\n  line3\r\n  line4\r\n" + more()));
+    EXPECT_EQ(_pulled, 6);
+
+    _ioStream.clearOutput();
+    send("\r");
+    EXPECT_THAT(_ioStream.getOutput(), testing::HasSubstr("line5\r\n" + more()));
+    EXPECT_THAT(_ioStream.getOutput(), testing::Not(testing::HasSubstr("line6")));
+  }
+
+  TEST_F(PagerTest, CrLfIsOneEnter)
+  {
+    // The line feed of the submitting CR LF does not advance the first page
+    send("dump\r\n");
+    EXPECT_EQ(_pulled, 3);
+    EXPECT_THAT(_ioStream.getOutput(), testing::Not(testing::HasSubstr("line2")));
+
+    _ioStream.clearOutput();
+    send("\r\n");
+    EXPECT_THAT(_ioStream.getOutput(), testing::HasSubstr("line2\r\n" + more()));
+    EXPECT_THAT(_ioStream.getOutput(), testing::Not(testing::HasSubstr("line3")));
+
+    // A lone line feed still counts
+    _ioStream.clearOutput();
+    send("\n");
+    EXPECT_THAT(_ioStream.getOutput(), testing::HasSubstr("line3\r\n" + more()));
+  }
+
+  TEST_F(PagerTest, LastPageRestoresPrompt)
+  {
+    send("dump\n");
+    send("   ");  // Three more pages cover the remaining lines
+
+    EXPECT_EQ(_pulled, DUMP_LINES);
+    EXPECT_THAT(_ioStream.getOutput(), testing::HasSubstr("line9\r\n"));
+    EXPECT_THAT(_ioStream.getOutput(), testing::EndsWith("user@/> "));
+    EXPECT_TRUE(_source.expired());
+
+    // Back to normal line editing
+    EXPECT_CALL(*_shortCmd, execute(testing::_));
+    send("short\n");
+  }
+
+  TEST_F(PagerTest, QuitStopsGeneration)
+  {
+    send("dump\n");
+    _ioStream.clearOutput();
+    send("q");
+
+    EXPECT_EQ(_pulled, 3);
+    EXPECT_TRUE(_source.expired());
+    EXPECT_THAT(_ioStream.getOutput(), testing::EndsWith("user@/> "));
+  }
+
+  TEST_F(PagerTest, OtherKeysAreIgnoredWhilePaging)
+  {
+    send("dump\n");
+    _ioStream.clearOutput();
+    send("xyz\t\x7f");
+
+    EXPECT_EQ(_ioStream.getOutput(), "");
+    EXPECT_EQ(_pulled, 3);
+  }
+
+  TEST_F(PagerTest, ShortOutputIsNotPaged)
+  {
+    send("short\n");
+
+    EXPECT_THAT(_ioStream.getOutput(), testing::HasSubstr("  a\r\n  b\r\n"));
+    EXPECT_THAT(_ioStream.getOutput(), testing::Not(testing::HasSubstr(more())));
+    EXPECT_THAT(_ioStream.getOutput(), testing::EndsWith("user@/> "));
+  }
+
+  TEST_F(PagerTest, TreeIsPaged)
+  {
+    send("tree\n");
+
+    EXPECT_THAT(_ioStream.getOutput(), testing::HasSubstr("  root/\r\n    dump\r\n    short\r\n"));
+    EXPECT_THAT(_ioStream.getOutput(), testing::Not(testing::HasSubstr(more())));
+
+    _ioStream.clearOutput();
+    send("help\n");
+    EXPECT_THAT(_ioStream.getOutput(), testing::HasSubstr(more()));
+  }
+
+}
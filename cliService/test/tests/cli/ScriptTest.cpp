@@ -0,0 +1,227 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "cliService/cli/CLIService.hpp"
+#include "cliService/cli/FileScriptLoader.hpp"
+#include "cliService/cli/Script.hpp"
+#include "mock/command/CommandMock.hpp"
+#include "mock/io/CharIOStreamMock.hpp"
+#include <fstream>
+#include <map>
+
+namespace cliService
+{
+
+  class MapScriptLoader : public ScriptLoaderIf
+  {
+  public:
+    bool load(std::string_view name, std::string& content) override
+    {
+      auto it = scripts.find(std::string(name));
+      if (it == scripts.end()) { return false; }
+
+      content = it->second;
+      return true;
+    }
+
+    std::map<std::string, std::string> scripts;
+  };
+
+  class ScriptTest : public ::testing::Test
+  {
+  protected:
+    void SetUp() override
+    {
+      auto root = std::make_unique<Directory>("root", AccessLevel::User);
+      auto& hwDir = root->addDynamicDirectory("hw", AccessLevel::User);
+      _setCmd = &hwDir.addDynamicCommand<CommandMock>("set", AccessLevel::User);
+      _failCmd = &root->addDynamicCommand<CommandMock>("fail", AccessLevel::User);
+      _adminCmd = &root->addDynamicCommand<CommandMock>("secret", AccessLevel::Admin);
+
+      ON_CALL(*_setCmd, execute(testing::_)).WillByDefault([](const std::vector<std::string>& args) {
+        return CLIResponse::success("set " + std::to_string(args.size()));
+      });
+      ON_CALL(*_failCmd, execute(testing::_)).WillByDefault(testing::Return(CLIResponse::error(std::string("failed"))));
+
+      CLIServiceConfiguration config{_ioStream, {{"user", "user123", AccessLevel::User}}, std::move(root), 1000, 10};
+      config._scriptLoader = &_loader;
+      _service = std::make_unique<CLIService>(std::move(config));
+
+      _service->activate();
+      send("user:user123\n");
+      _ioStream.clearOutput();
+    }
+
+    void send(const std::string& input)
+    {
+      _ioStream.queueInput(input);
+      while (_ioStream.available()) {
+        _service->service();
+      }
+    }
+
+    MapScriptLoader _loader;
+    CharIOStreamMock _ioStream;
+    CommandMock* _setCmd;
+    CommandMock* _failCmd;
+    CommandMock* _adminCmd;
+    std::unique_ptr<CLIService> _service;
+  };
+
+  TEST_F(ScriptTest, RunsLinesThroughCommandPath)
+  {
+    EXPECT_CALL(*_setCmd, execute(std::vector<std::string>{"1", "255"})).Times(2);
+    EXPECT_CALL(*_adminCmd, execute(testing::_)).Times(0);
+
+    const auto result = _service->runScript(
+      "# provisioning\r\n"
+      "hw/set 1 255\r\n"
+      "\r\n"
+      "  hw\r\n"
+      "set 1 255\r\n"
+      "/secret\r\n");
+
+    EXPECT_EQ(result.executed, 4u);
+    EXPECT_EQ(result.failed, 1u);
+    EXPECT_EQ(result.stoppedAtLine, 0u);
+
+    const std::string output = _ioStream.getOutput();
+    EXPECT_THAT(output, testing::HasSubstr("user@/> hw/set 1 255\r\n\r\n  set 2\r\n"));
+    EXPECT_THAT(output, testing::HasSubstr("user@/hw> set 1 255\r\n"));
+    EXPECT_THAT(output, testing::HasSubstr(CLIMessages::getDefaults().getAccessDeniedMessage()));
+    EXPECT_THAT(output, testing::Not(testing::HasSubstr("provisioning")));
+  }
+
+  TEST_F(ScriptTest, StopsOnFirstErrorAndSuppressesPrompts)
+  {
+    EXPECT_CALL(*_setCmd, execute(testing::_)).Times(1);
+
+    ScriptOptions options;
+    options.stopOnError = true;
+    options.showPrompts = false;
+
+    const auto result = _service->runScript("hw/set\nfail\nhw/set\n", options);
+
+    EXPECT_EQ(result.executed, 2u);
+    EXPECT_EQ(result.failed, 1u);
+    EXPECT_EQ(result.stoppedAtLine, 2u);
+    EXPECT_EQ(_ioStream.getOutput(), "\r\n  set 0\r\n\r\n\r\n  failed\r\n\r\n");
+  }
+
+  TEST_F(ScriptTest, LinesStayOutOfHistory)
+  {
+    _service->runScript("hw/set 1\n");
+    _ioStream.clearOutput();
+
+    send("\x1b[A");
+    EXPECT_THAT(_ioStream.getOutput(), testing::Not(testing::HasSubstr("hw/set")));
+  }
+
+  TEST_F(ScriptTest, SourceCommand)
+  {
+    _loader.scripts["setup"] = "hw/set a\nfail\nhw/set b c\n";
+
+    send("source -q setup\n");
+    std::string output = _ioStream.getOutput();
+    EXPECT_THAT(output, testing::HasSubstr("set 1"));
+    EXPECT_THAT(output, testing::HasSubstr("set 2"));
+    EXPECT_THAT(output, testing::HasSubstr("3 commands, 1 failed"));
+    EXPECT_THAT(output, testing::EndsWith("user@/> "));
+
+    _ioStream.clearOutput();
+    send("source -e setup\n");
+    output = _ioStream.getOutput();
+    EXPECT_THAT(output, testing::HasSubstr("2 commands, 1 failed, stopped at line 2"));
+    EXPECT_THAT(output, testing::Not(testing::HasSubstr("set 2")));
+  }
+
+  TEST_F(ScriptTest, SourceErrors)
+  {
+    _loader.scripts["loop"] = "source loop\n";
+
+    const std::vector<std::pair<std::string, std::string>> cases = {
+      {"source\n", "Usage: source [-e] [-q] <name>"},
+      {"source a b\n", "Usage: source [-e] [-q] <name>"},
+      {"source -x a\n", "Usage: source [-e] [-q] <name>"},
+      {"source missing\n", "Script not found: missing"},
+      {"source loop\n", "Scripts nested too deeply"}
+    };
+
+    for (const auto& [input, expected] : cases)
+    {
+      _ioStream.clearOutput();
+      send(input);
+      EXPECT_THAT(_ioStream.getOutput(), testing::HasSubstr(expected)) << input;
+    }
+  }
+
+  TEST_F(ScriptTest, SourceWithoutLoader)
+  {
+    CharIOStreamMock ioStream;
+    Directory root("root", AccessLevel::User);
+    CLIService service(CLIServiceConfiguration{ioStream, {{"user", "user123", AccessLevel::User}}, root, 1000, 10});
+
+    service.activate();
+    ioStream.queueInput("user:user123\nsource setup\n");
+    service.service();
+    service.service();
+
+    EXPECT_THAT(ioStream.getOutput(), testing::HasSubstr("Scripts are not supported"));
+  }
+
+  TEST_F(ScriptTest, SourceNeedsConfiguredLevel)
+  {
+    CharIOStreamMock ioStream;
+    Directory root("root", AccessLevel::User);
+    CLIServiceConfiguration config{ioStream, {{"user", "user123", AccessLevel::User}, {"admin", "admin123", AccessLevel::Admin}}, root, 1000, 10};
+    config._scriptLoader = &_loader;
+    config._scriptAccessLevel = AccessLevel::Admin;
+    CLIService service(std::move(config));
+    _loader.scripts["setup"] = "# nothing\n";
+
+    service.activate();
+    ioStream.queueInput("user:user123\n");
+    service.service();
+    ioStream.queueInput("source setup\n");
+    service.service();
+    EXPECT_THAT(ioStream.getOutput(), testing::HasSubstr(CLIMessages::getDefaults().getAccessDeniedMessage()));
+
+    ioStream.queueInput("logout\n");
+    service.service();
+    ioStream.queueInput("admin:admin123\n");
+    service.service();
+    ioStream.clearOutput();
+    ioStream.queueInput("source setup\n");
+    service.service();
+    EXPECT_THAT(ioStream.getOutput(), testing::HasSubstr("0 commands, 0 failed"));
+  }
+
+  TEST(FileScriptLoaderTest, StaysBelowBaseDirectory)
+  {
+    const std::string base = testing::TempDir();
+    std::ofstream(base + "/cli_script_test.txt") << "hw/set a\n";
+
+    FileScriptLoader loader(base);
+    std::string content;
+    EXPECT_TRUE(loader.load("cli_script_test.txt", content));
+    EXPECT_EQ(content, "hw/set a\n");
+    EXPECT_TRUE(loader.load("./cli_script_test.txt", content));
+
+    for (const char* name : {"", "/etc/passwd", "../etc/passwd", "a/../../b", "..", "dir/..", "C:\\x", "a\\..\\b"}) {
+      EXPECT_FALSE(loader.load(name, content)) << name;
+    }
+
+    EXPECT_TRUE(FileScriptLoader::isConfined("a/..b/c.."));
+  }
+
+  TEST_F(ScriptTest, LogoutEndsScript)
+  {
+    EXPECT_CALL(*_setCmd, execute(testing::_)).Times(0);
+
+    const auto result = _service->runScript("logout\nhw/set\n");
+
+    EXPECT_EQ(result.executed, 1u);
+    EXPECT_EQ(result.stoppedAtLine, 1u);
+    EXPECT_EQ(_service->getCLIState(), CLIState::LoggedOut);
+  }
+
+}
@@ -0,0 +1,125 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "cliService/cli/CLIService.hpp"
+#include "cliService/cli/RingBufferTracer.hpp"
+#include "mock/clock/ClockMock.hpp"
+#include "mock/command/CommandMock.hpp"
+#include "mock/io/CharIOStreamMock.hpp"
+
+namespace cliService
+{
+
+  TEST(RingBufferTracerTest, KeepsMostRecentEventsInOrder)
+  {
+    RingBufferTracer tracer(3);
+    EXPECT_EQ(tracer.capacity(), 3u);
+
+    tracer.record(TracePhase::Parse, 0, 1, "");
+    tracer.record(TracePhase::Resolve, 1, 2, "");
+    EXPECT_EQ(tracer.size(), 2u);
+
+    tracer.record(TracePhase::Authorize, 2, 3, "a");
+    tracer.record(TracePhase::Execute, 3, 4, "b");
+    tracer.record(TracePhase::Render, 4, 5, "");
+
+    auto events = tracer.getEvents();
+    ASSERT_EQ(events.size(), 3u);
+    EXPECT_EQ(events[0].phase, TracePhase::Authorize);
+    EXPECT_EQ(events[1].phase, TracePhase::Execute);
+    EXPECT_EQ(events[1].detail, "b");
+    EXPECT_EQ(events[2].phase, TracePhase::Render);
+    EXPECT_EQ(tracer.getDroppedCount(), 2u);
+
+    tracer.clear();
+    EXPECT_TRUE(tracer.getEvents().empty());
+  }
+
+  TEST(RingBufferTracerTest, ChromeTraceJson)
+  {
+    RingBufferTracer tracer(4);
+    EXPECT_EQ(tracer.toChromeTraceJson(), "{\"traceEvents\":[]}");
+
+    tracer.record(TracePhase::Resolve, 100, 105, "");
+    tracer.record(TracePhase::Execute, 110, 150, "say\"hi\"");
+
+    EXPECT_EQ(tracer.toChromeTraceJson(),
+      "{\"traceEvents\":["
+      "{\"name\":\"resolve\",\"cat\":\"cliService\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":100,\"dur\":5},"
+      "{\"name\":\"execute\",\"cat\":\"cliService\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":110,\"dur\":40,"
+      "\"args\":{\"node\":\"say\\\"hi\\\"\"}}"
+      "]}");
+  }
+
+  class TracerTest : public ::testing::Test
+  {
+  protected:
+    void SetUp() override
+    {
+      auto root = std::make_unique<Directory>("root", AccessLevel::User);
+      auto& system = root->addDynamicDirectory("system", AccessLevel::User);
+      _cmd = &system.addDynamicCommand<CommandMock>("status", AccessLevel::User);
+      system.addDynamicCommand<CommandMock>("reboot", AccessLevel::Admin);
+
+      CLIServiceConfiguration config{_ioStream, {{"user", "user123", AccessLevel::User}}, std::move(root), 1000, 10};
+      config._clock = &_clock;
+      config._tracer = &_tracer;
+      _service = std::make_unique<CLIService>(std::move(config));
+
+      _service->activate();
+      _ioStream.queueInput("user:user123\n");
+      _service->service();
+      _tracer.clear();
+    }
+
+    std::vector<TracePhase> phases() const
+    {
+      std::vector<TracePhase> result;
+      for (const auto& event : _tracer.getEvents()) { result.push_back(event.phase); }
+      return result;
+    }
+
+    CharIOStreamMock _ioStream;
+    ClockMock _clock;
+    RingBufferTracer _tracer{32};
+    CommandMock* _cmd;
+    std::unique_ptr<CLIService> _service;
+  };
+
+  TEST_F(TracerTest, CommandRunsThroughAllPhases)
+  {
+    EXPECT_CALL(*_cmd, execute(testing::_))
+        .WillOnce(testing::DoAll(
+          testing::InvokeWithoutArgs([this]() { _clock.advance_us(250); }),
+          testing::Return(CLIResponse::success(std::string("ok")))));
+
+    _ioStream.queueInput("system/status\n");
+    _service->service();
+
+    // Events are recorded as phases complete
+    EXPECT_EQ(phases(), (std::vector<TracePhase>{
+      TracePhase::Parse, TracePhase::Resolve, TracePhase::Authorize, TracePhase::Execute, TracePhase::Render}));
+
+    auto events = _tracer.getEvents();
+    EXPECT_EQ(events[2].detail, "status");
+    EXPECT_EQ(events[3].detail, "status");
+    EXPECT_EQ(events[3].end_us - events[3].begin_us, 250u);
+  }
+
+  TEST_F(TracerTest, DeniedCommandIsNotExecuted)
+  {
+    _ioStream.queueInput("system/reboot\n");
+    _service->service();
+
+    EXPECT_EQ(phases(), (std::vector<TracePhase>{
+      TracePhase::Parse, TracePhase::Resolve, TracePhase::Authorize, TracePhase::Render}));
+  }
+
+  TEST_F(TracerTest, KeystrokesAreNotTraced)
+  {
+    _ioStream.queueInput("sys");
+    _service->service();
+
+    EXPECT_TRUE(_tracer.getEvents().empty());
+  }
+
+}
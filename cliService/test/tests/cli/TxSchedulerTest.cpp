@@ -0,0 +1,284 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "cliService/cli/CLIService.hpp"
+#include "cliService/cli/TxScheduler.hpp"
+#include "mock/clock/ClockMock.hpp"
+#include "mock/command/CommandMock.hpp"
+#include "mock/io/CharIOStreamMock.hpp"
+
+namespace cliService
+{
+
+  class TxSchedulerTest : public ::testing::Test
+  {
+  protected:
+    CharIOStreamMock _ioStream;
+    ClockMock _clock;
+  };
+
+  TEST_F(TxSchedulerTest, UnpacedWritesThrough)
+  {
+    TxScheduler scheduler(_ioStream, _clock, 0, 0);
+
+    scheduler.write("abc", TxPriority::Bulk);
+    scheduler.write("d", TxPriority::Interactive);
+
+    EXPECT_EQ(_ioStream.getOutput(), "abcd");
+    EXPECT_FALSE(scheduler.isPaced());
+    EXPECT_TRUE(scheduler.isIdle());
+    EXPECT_EQ(scheduler.getFreeSpace(TxPriority::Bulk), TxScheduler::UNLIMITED_SPACE);
+    EXPECT_EQ(scheduler.getSentCount(), 4u);
+  }
+
+  TEST_F(TxSchedulerTest, PacesToByteRate)
+  {
+    TxScheduler scheduler(_ioStream, _clock, 1000, 256);
+
+    scheduler.write(std::string(100, 'b'), TxPriority::Bulk);
+    scheduler.pump();
+    EXPECT_EQ(_ioStream.getOutput().length(), 0u);
+    EXPECT_EQ(scheduler.getQueueDepth(TxPriority::Bulk), 100u);
+
+    _clock.advance_ms(10);
+    scheduler.pump();
+    EXPECT_EQ(_ioStream.getOutput().length(), 10u);
+
+    // A long gap is worth at most one burst
+    _clock.advance_ms(500);
+    scheduler.pump();
+    EXPECT_EQ(_ioStream.getOutput().length(), 20u);
+    EXPECT_EQ(scheduler.getQueueDepth(TxPriority::Bulk), 80u);
+  }
+
+  TEST_F(TxSchedulerTest, KeepsFractionalCredit)
+  {
+    TxScheduler scheduler(_ioStream, _clock, 150, 256);
+    scheduler.write(std::string(10, 'b'), TxPriority::Bulk);
+
+    for (int i = 0; i < 20; ++i)
+    {
+      _clock.advance_ms(1);
+      scheduler.pump();
+    }
+
+    EXPECT_EQ(_ioStream.getOutput(), "bbb");
+  }
+
+  TEST_F(TxSchedulerTest, InteractiveBytesGoFirst)
+  {
+    TxScheduler scheduler(_ioStream, _clock, 1000, 256);
+
+    scheduler.write("bulk output", TxPriority::Bulk);
+    scheduler.write("xy", TxPriority::Interactive);
+    EXPECT_EQ(scheduler.getQueueDepth(TxPriority::Interactive), 2u);
+
+    _clock.advance_ms(5);
+    scheduler.pump();
+    EXPECT_EQ(_ioStream.getOutput(), "xybul");
+
+    _clock.advance_ms(10);
+    scheduler.pump();
+    EXPECT_EQ(_ioStream.getOutput(), "xybulk output");
+    EXPECT_TRUE(scheduler.isIdle());
+  }
+
+  TEST_F(TxSchedulerTest, FenceHoldsLaterInteractiveBytes)
+  {
+    TxScheduler scheduler(_ioStream, _clock, 1000, 256);
+
+    scheduler.write("a", TxPriority::Interactive);
+    scheduler.write("prompt> ", TxPriority::Bulk);
+    scheduler.fence();
+    scheduler.write("xy", TxPriority::Interactive);
+
+    // Bytes queued before the fence still go first
+    _clock.advance_ms(5);
+    scheduler.pump();
+    EXPECT_EQ(_ioStream.getOutput(), "aprom");
+
+    _clock.advance_ms(10);
+    scheduler.pump();
+    EXPECT_EQ(_ioStream.getOutput(), "aprompt> xy");
+
+    // Once reached, the fence no longer holds anything back
+    scheduler.write("more output", TxPriority::Bulk);
+    scheduler.write("z", TxPriority::Interactive);
+    _clock.advance_ms(1);
+    scheduler.pump();
+    EXPECT_THAT(_ioStream.getOutput(), testing::StartsWith("aprompt> xyz"));
+  }
+
+  TEST_F(TxSchedulerTest, FullQueuesFlushEarly)
+  {
+    TxScheduler scheduler(_ioStream, _clock, 1000, 8);
+
+    // The oldest bulk bytes make room for new ones
+    scheduler.write("0123456789ab", TxPriority::Bulk);
+    EXPECT_EQ(_ioStream.getOutput(), "0123");
+    EXPECT_EQ(scheduler.getQueueDepth(TxPriority::Bulk), 8u);
+    EXPECT_EQ(scheduler.getFreeSpace(TxPriority::Bulk), 0u);
+    EXPECT_EQ(scheduler.getPeakQueueDepth(TxPriority::Bulk), 8u);
+
+    // Keystrokes are never dropped
+    _ioStream.clearOutput();
+    scheduler.write(std::string(TxScheduler::INTERACTIVE_CAPACITY, 'i'), TxPriority::Interactive);
+    scheduler.write("j", TxPriority::Interactive);
+    EXPECT_EQ(_ioStream.getOutput(), std::string(TxScheduler::INTERACTIVE_CAPACITY, 'i') + "j");
+    EXPECT_EQ(scheduler.getQueueDepth(TxPriority::Interactive), 0u);
+  }
+
+  TEST_F(TxSchedulerTest, WrapsAroundTheRing)
+  {
+    TxScheduler scheduler(_ioStream, _clock, 1000, 8);
+
+    scheduler.write("abcdef", TxPriority::Bulk);
+    _clock.advance_ms(5);
+    scheduler.pump();
+    scheduler.write("ghijk", TxPriority::Bulk);
+
+    _clock.advance_ms(10);
+    scheduler.pump();
+    EXPECT_EQ(_ioStream.getOutput(), "abcdefghijk");
+  }
+
+
+  class PacedCLIServiceTest : public ::testing::Test
+  {
+  protected:
+    static constexpr uint32_t BYTES_PER_SECOND = 11520;
+    static constexpr size_t QUEUE_CAPACITY = 1024;
+    static constexpr int DUMP_LINES = 500;
+
+    void SetUp() override
+    {
+      auto root = std::make_unique<Directory>("root", AccessLevel::User);
+      auto& dumpCmd = root->addDynamicCommand<CommandMock>("dump", AccessLevel::User);
+      auto& shortCmd = root->addDynamicCommand<CommandMock>("short", AccessLevel::User);
+
+      ON_CALL(dumpCmd, execute(testing::_)).WillByDefault([this](const std::vector<std::string>&) {
+        CLIResponse response = CLIResponse::success();
+        response.setOutputSource(std::make_shared<CallbackOutputSource>([this](std::string& line) {
+          if (_pulled == DUMP_LINES) { return false; }
+          line = "line" + std::to_string(_pulled++);
+          return true;
+        }));
+        return response;
+      });
+      ON_CALL(shortCmd, execute(testing::_)).WillByDefault(testing::Return(CLIResponse::success(std::string("short done"))));
+
+      CLIServiceConfiguration config{_ioStream, {{"user", "user123", AccessLevel::User}}, std::move(root), 1000, 10};
+      config._clock = &_clock;
+      config._txBytesPerSecond = BYTES_PER_SECOND;
+      config._txQueueCapacity = QUEUE_CAPACITY;
+      _service = std::make_unique<CLIService>(std::move(config));
+
+      _service->activate();
+      _ioStream.queueInput("user:user123\n");
+      drain();
+      _ioStream.clearOutput();
+    }
+
+    // Run the service in 1 ms steps until everything went out
+    void drain()
+    {
+      for (int i = 0; i < 100000; ++i)
+      {
+        _clock.advance_ms(1);
+        _service->service();
+
+        if (!_ioStream.available() && _service->getTxScheduler().isIdle()) { return; }
+      }
+
+      FAIL() << "Output never drained";
+    }
+
+    CharIOStreamMock _ioStream;
+    ClockMock _clock;
+    std::unique_ptr<CLIService> _service;
+    int _pulled = 0;
+  };
+
+  TEST_F(PacedCLIServiceTest, LargeOutputDrainsWithBoundedQueue)
+  {
+    _ioStream.queueInput("dump\n");
+    _service->service();
+
+    // Only what fits the queue is pulled up front
+    EXPECT_LT(_pulled, DUMP_LINES);
+    EXPECT_LE(_service->getTxScheduler().getQueueDepth(TxPriority::Bulk), QUEUE_CAPACITY);
+
+    const uint64_t start_us = _clock.now_us();
+    drain();
+
+    const std::string output = _ioStream.getOutput();
+    EXPECT_EQ(_pulled, DUMP_LINES);
+    EXPECT_THAT(output, testing::HasSubstr("line0\r\n"));
+    EXPECT_THAT(output, testing::EndsWith("line499\r\n\r\nuser@/> "));
+    EXPECT_LE(_service->getTxScheduler().getPeakQueueDepth(TxPriority::Bulk), QUEUE_CAPACITY);
+
+    // Never faster than the configured rate
+    const uint64_t elapsed_us = _clock.now_us() - start_us;
+    EXPECT_GE(elapsed_us, output.length() * 1000000 / BYTES_PER_SECOND - TxScheduler::MAX_BURST_US);
+  }
+
+  TEST_F(PacedCLIServiceTest, EchoOvertakesQueuedOutput)
+  {
+    _ioStream.queueInput("dump\n");
+    _service->service();
+    _clock.advance_ms(1);
+    _service->service();
+    _ioStream.clearOutput();
+
+    _ioStream.queueInput("s");
+    _clock.advance_ms(1);
+    _service->service();
+    EXPECT_EQ(_ioStream.getOutput().front(), 's');
+
+    // Typed ahead input is shown again after the final prompt
+    drain();
+    EXPECT_THAT(_ioStream.getOutput(), testing::EndsWith("line499\r\n\r\nuser@/> s"));
+  }
+
+  TEST_F(PacedCLIServiceTest, KeysTypedAfterTabFollowTheCompletion)
+  {
+    _ioStream.queueInput("sh\tx");
+    drain();
+
+    EXPECT_EQ(_ioStream.getOutput(), "shortx");
+  }
+
+  TEST_F(PacedCLIServiceTest, KeysTypedAfterQueuedPromptFollowIt)
+  {
+    _ioStream.queueInput("short\nab");
+    drain();
+
+    EXPECT_THAT(_ioStream.getOutput(), testing::HasSubstr("short done"));
+    EXPECT_THAT(_ioStream.getOutput(), testing::EndsWith("user@/> ab"));
+  }
+
+  TEST_F(PacedCLIServiceTest, CommandsWaitForPreviousOutput)
+  {
+    _ioStream.queueInput("dump\n");
+    _service->service();
+    _ioStream.queueInput("short\n");
+    drain();
+
+    const std::string output = _ioStream.getOutput();
+    const size_t dumpEnd = output.find("line499");
+    const size_t shortOutput = output.find("short done");
+
+    ASSERT_NE(dumpEnd, std::string::npos);
+    ASSERT_NE(shortOutput, std::string::npos);
+    EXPECT_GT(shortOutput, dumpEnd);
+  }
+
+  TEST_F(PacedCLIServiceTest, StatsReportQueueDepth)
+  {
+    _ioStream.queueInput("stats\n");
+    drain();
+
+    EXPECT_THAT(_ioStream.getOutput(), testing::HasSubstr("tx: 11520 bytes/s"));
+    EXPECT_THAT(_ioStream.getOutput(), testing::ContainsRegex("queued: interactive [0-9]+ \\(peak [0-9]+\\), bulk [0-9]+"));
+  }
+
+}
@@ -0,0 +1,162 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "cliService/cli/CLIService.hpp"
+#include "cliService/cli/Sha256.hpp"
+#include "cliService/cli/UserStore.hpp"
+#include "mock/command/CommandMock.hpp"
+#include "mock/io/CharIOStreamMock.hpp"
+
+namespace cliService
+{
+
+  static std::string toHex(const uint8_t* data, size_t length)
+  {
+    static constexpr char DIGITS[] = "0123456789abcdef";
+    std::string hex;
+
+    for (size_t i = 0; i < length; ++i)
+    {
+      hex += DIGITS[data[i] >> 4];
+      hex += DIGITS[data[i] & 0x0F];
+    }
+
+    return hex;
+  }
+
+  static std::string toHex(const Sha256::Digest& digest)
+  {
+    return toHex(digest.data(), digest.size());
+  }
+
+  TEST(Sha256Test, KnownDigests)
+  {
+    EXPECT_EQ(toHex(Sha256::hash("")), "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+    EXPECT_EQ(toHex(Sha256::hash("abc")), "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    EXPECT_EQ(toHex(Sha256::hash("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq")),
+              "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+
+    // Fed in uneven pieces across block boundaries
+    const std::string input(1000, 'a');
+    Sha256 sha;
+    for (size_t offset = 0; offset < input.length(); offset += 7) {
+      sha.update(std::string_view(input).substr(offset, 7));
+    }
+    EXPECT_EQ(toHex(sha.finish()), toHex(Sha256::hash(input)));
+  }
+
+  TEST(Sha256Test, Hmac)
+  {
+    // RFC 4231 test cases 1, 2 and 6 (key longer than a block)
+    EXPECT_EQ(toHex(hmacSha256(std::string(20, '\x0b'), "Hi There")),
+              "b0344c61d8db38535ca8afceaf0bf12b881dc200c9833da726e9376c2e32cff7");
+    EXPECT_EQ(toHex(hmacSha256("Jefe", "what do ya want for nothing?")),
+              "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843");
+    EXPECT_EQ(toHex(hmacSha256(std::string(131, '\xaa'), "Test Using Larger Than Block-Size Key - Hash Key First")),
+              "60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54");
+  }
+
+  TEST(Sha256Test, Pbkdf2)
+  {
+    uint8_t key[64];
+
+    pbkdf2Sha256("password", "salt", 1, key, 32);
+    EXPECT_EQ(toHex(key, 32), "120fb6cffcf8b32c43e7225256c4f837a86548c92ccc35480805987cb70be17b");
+
+    pbkdf2Sha256("password", "salt", 4096, key, 32);
+    EXPECT_EQ(toHex(key, 32), "c5e478d59288c841aa530db6845c4c8d962893a001ce4e11a4963873aa98134a");
+
+    // More than one block of output (RFC 7914)
+    pbkdf2Sha256("passwd", "salt", 1, key, 64);
+    EXPECT_EQ(toHex(key, 64), "55ac046e56e3089fec1691c22544b605f94185216dde0465e68b9d57c20dacbc"
+                              "49ca9cccf179b645991664b39d77ef317c71b845b1e30bd509112041d3a19783");
+  }
+
+  TEST(Sha256Test, ConstantTimeEquals)
+  {
+    const uint8_t a[] = {1, 2, 3, 4};
+    const uint8_t b[] = {1, 2, 3, 5};
+
+    EXPECT_TRUE(constantTimeEquals(a, a, sizeof(a)));
+    EXPECT_FALSE(constantTimeEquals(a, b, sizeof(a)));
+    EXPECT_TRUE(constantTimeEquals(a, b, 3));
+  }
+
+
+  TEST(UserStoreTest, Authenticate)
+  {
+    UserStore store(10);
+    EXPECT_TRUE(store.addUser({"admin", "admin123", AccessLevel::Admin}));
+    EXPECT_TRUE(store.addUser({"user", "user123", AccessLevel::User}));
+    EXPECT_FALSE(store.addUser({"user", "other", AccessLevel::Admin}));
+
+    const User* admin = store.authenticate("admin", "admin123");
+    ASSERT_NE(admin, nullptr);
+    EXPECT_EQ(admin->getUsername(), "admin");
+    EXPECT_EQ(admin->getAccessLevel(), AccessLevel::Admin);
+    EXPECT_TRUE(admin->getPassword().empty());
+
+    EXPECT_EQ(store.authenticate("admin", "admin124"), nullptr);
+    EXPECT_EQ(store.authenticate("admin", ""), nullptr);
+    EXPECT_EQ(store.authenticate("nobody", ""), nullptr);
+    EXPECT_EQ(store.authenticate("user", "admin123"), nullptr);
+    EXPECT_NE(store.authenticate("user", "user123"), nullptr);
+  }
+
+  TEST(UserStoreTest, ProvisionedHashes)
+  {
+    const UserStore::Salt salt = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+    const auto hash = UserStore::hashPassword("secret", salt, 50);
+
+    // Accounts keep their own work factor
+    UserStore store(10);
+    EXPECT_TRUE(store.addHashedUser("service", AccessLevel::User, salt, hash, 50));
+
+    EXPECT_NE(store.authenticate("service", "secret"), nullptr);
+    EXPECT_EQ(store.authenticate("service", "Secret"), nullptr);
+  }
+
+  TEST(UserStoreTest, AttemptsCostTheHighestWorkFactor)
+  {
+    const UserStore::Salt salt = {16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1};
+
+    UserStore store(10, 42);
+    EXPECT_EQ(store.getVerificationIterations(), 10u);
+
+    EXPECT_TRUE(store.addHashedUser("strong", AccessLevel::Admin, salt, UserStore::hashPassword("strong", salt, 50), 50));
+    EXPECT_TRUE(store.addHashedUser("legacy", AccessLevel::User, salt, UserStore::hashPassword("legacy", salt, 20), 20));
+    EXPECT_FALSE(store.addHashedUser("strong", AccessLevel::User, salt, UserStore::hashPassword("strong", salt, 90), 90));
+    EXPECT_TRUE(store.addUser({"local", "local", AccessLevel::User}));
+    EXPECT_EQ(store.getVerificationIterations(), 50u);
+
+    // Cheaper accounts are padded up to it and still verify
+    EXPECT_NE(store.authenticate("strong", "strong"), nullptr);
+    EXPECT_NE(store.authenticate("legacy", "legacy"), nullptr);
+    EXPECT_NE(store.authenticate("local", "local"), nullptr);
+    EXPECT_EQ(store.authenticate("legacy", "strong"), nullptr);
+    EXPECT_EQ(store.authenticate("nobody", ""), nullptr);
+  }
+
+  TEST(UserStoreTest, ServiceLogsInAgainstStore)
+  {
+    UserStore store(10);
+    store.addUser({"ops", "hunter2", AccessLevel::Admin});
+
+    CharIOStreamMock ioStream;
+    Directory root("root", AccessLevel::User);
+    CLIServiceConfiguration config{ioStream, {}, root, 1000, 10};
+    config._userStore = &store;
+    CLIService service(std::move(config));
+
+    service.activate();
+    ioStream.queueInput("ops:wrong\n");
+    service.service();
+    EXPECT_EQ(service.getCLIState(), CLIState::LoggedOut);
+    EXPECT_THAT(ioStream.getOutput(), testing::HasSubstr(CLIMessages::getDefaults().getInvalidLoginMessage()));
+
+    ioStream.queueInput("ops:hunter2\n");
+    service.service();
+    EXPECT_EQ(service.getCLIState(), CLIState::LoggedIn);
+    EXPECT_THAT(ioStream.getOutput(), testing::EndsWith("ops@/> "));
+  }
+
+}
@@ -0,0 +1,189 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "cliService/cli/CLIService.hpp"
+#include "cliService/cli/WatchView.hpp"
+#include "mock/clock/ClockMock.hpp"
+#include "mock/command/CommandMock.hpp"
+#include "mock/io/CharIOStreamMock.hpp"
+
+namespace cliService
+{
+
+  TEST(WatchViewTest, FirstDrawWritesEveryLine)
+  {
+    WatchView view(3);
+    std::string out;
+
+    view.update({"pot: 512", "", "switch: off"}, out);
+
+    EXPECT_EQ(out, "\033[3;1Hpot: 512\033[5;1Hswitch: off");
+    EXPECT_EQ(view.getLineCount(), 3u);
+  }
+
+  TEST(WatchViewTest, RedrawsOnlyChangedCharacters)
+  {
+    WatchView view(3);
+    std::string out;
+    view.update({"pot: 512", "switch: off"}, out);
+
+    // Nothing changed, nothing sent
+    out.clear();
+    view.update({"pot: 512", "switch: off"}, out);
+    EXPECT_EQ(out, "");
+
+    // Same length: just the differing span
+    view.update({"pot: 517", "switch: off"}, out);
+    EXPECT_EQ(out, "\033[3;8H7");
+
+    // Longer and shorter lines: the rest of the line, shorter ones erased behind
+    out.clear();
+    view.update({"pot: 1023", "switch: on"}, out);
+    EXPECT_EQ(out, "\033[3;6H1023\033[4;10Hn\033[K");
+  }
+
+  TEST(WatchViewTest, ErasesRemovedLines)
+  {
+    WatchView view(1);
+    std::string out;
+    view.update({"a", "b", "c"}, out);
+
+    out.clear();
+    view.update({"a"}, out);
+    EXPECT_EQ(out, "\033[2;1H\033[K\033[3;1H\033[K");
+
+    out.clear();
+    view.moveBelow(out);
+    EXPECT_EQ(out, "\033[2;1H");
+  }
+
+
+  class WatchTest : public ::testing::Test
+  {
+  protected:
+    void SetUp() override
+    {
+      auto root = std::make_unique<Directory>("root", AccessLevel::User);
+      auto& hw = root->addDynamicDirectory("hw", AccessLevel::User);
+      _potCmd = &hw.addDynamicCommand<CommandMock>("pot", AccessLevel::User);
+      root->addDynamicCommand<CommandMock>("secret", AccessLevel::Admin);
+
+      ON_CALL(*_potCmd, execute(testing::_)).WillByDefault([this](const std::vector<std::string>&) {
+        return CLIResponse::success("pot: " + std::to_string(_value) + "\r\nstate: ok");
+      });
+
+      CLIServiceConfiguration config{_ioStream, {{"user", "user123", AccessLevel::User}}, std::move(root), 1000, 10};
+      config._clock = &_clock;
+      _service = std::make_unique<CLIService>(std::move(config));
+
+      _service->activate();
+      send("user:user123\r\n");
+      _ioStream.clearOutput();
+    }
+
+    void send(const std::string& input)
+    {
+      _ioStream.queueInput(input);
+      _service->service();
+    }
+
+    CharIOStreamMock _ioStream;
+    ClockMock _clock;
+    CommandMock* _potCmd;
+    int _value = 512;
+    std::unique_ptr<CLIService> _service;
+  };
+
+  TEST_F(WatchTest, RefreshesOnTheIntervalWithDifferentialRedraw)
+  {
+    EXPECT_CALL(*_potCmd, execute(std::vector<std::string>{"-r"})).Times(3);
+
+    send("watch -n 0.5 hw/pot -r\r\n");
+    EXPECT_THAT(_ioStream.getOutput(), testing::HasSubstr("\033[2J\033[HEvery 0.5s: hw/pot -r\r\n"));
+
+    // First refresh right away, the trailing line feed does not stop it
+    _ioStream.clearOutput();
+    _service->service();
+    EXPECT_EQ(_ioStream.getOutput(), "\033[3;1Hpot: 512\033[4;1Hstate: ok");
+
+    // Not due yet
+    _ioStream.clearOutput();
+    _clock.advance_ms(499);
+    _service->service();
+    EXPECT_EQ(_ioStream.getOutput(), "");
+
+    _value = 513;
+    _clock.advance_ms(1);
+    _service->service();
+    EXPECT_EQ(_ioStream.getOutput(), "\033[3;8H3");
+
+    // Unchanged output costs nothing
+    _ioStream.clearOutput();
+    _clock.advance_ms(500);
+    _service->service();
+    EXPECT_EQ(_ioStream.getOutput(), "");
+
+    // Any key stops, the prompt appears below the lines
+    send("q");
+    EXPECT_EQ(_ioStream.getOutput(), "\033[5;1H\r\nuser@/> ");
+
+    _clock.advance_ms(5000);
+    _service->service();
+    EXPECT_EQ(_ioStream.getOutput(), "\033[5;1H\r\nuser@/> ");
+  }
+
+  TEST_F(WatchTest, FiltersApplyToEveryRefresh)
+  {
+    send("watch hw/pot | grep pot\r");
+    _ioStream.clearOutput();
+    _service->service();
+
+    EXPECT_EQ(_ioStream.getOutput(), "\033[3;1Hpot: 512");
+  }
+
+  TEST_F(WatchTest, Errors)
+  {
+    EXPECT_CALL(*_potCmd, execute(testing::_)).Times(0);
+
+    const std::vector<std::pair<std::string, std::string>> cases = {
+      {"watch\r", "Usage: watch [-n seconds] <command>"},
+      {"watch -n 1\r", "Usage: watch [-n seconds] <command>"},
+      {"watch -n 0.05 hw/pot\r", "Interval must be 0.1 to 86400 seconds"},
+      {"watch -n x hw/pot\r", "Interval must be 0.1 to 86400 seconds"},
+      {"watch -n 1.2345 hw/pot\r", "Interval must be 0.1 to 86400 seconds"},
+      {"watch stats\r", "Only commands in the tree can be watched"},
+      {"watch hw\r", "Not a command: hw"},
+      {"watch missing\r", std::string(CLIMessages::getDefaults().getInvalidPathMessage())},
+      {"watch secret\r", std::string(CLIMessages::getDefaults().getAccessDeniedMessage())}
+    };
+
+    for (const auto& [input, expected] : cases)
+    {
+      _ioStream.clearOutput();
+      send(input);
+      EXPECT_THAT(_ioStream.getOutput(), testing::HasSubstr(expected)) << input;
+      EXPECT_THAT(_ioStream.getOutput(), testing::EndsWith("user@/> ")) << input;
+    }
+  }
+
+  TEST_F(WatchTest, FirstEnterStopsWithoutCrLf)
+  {
+    // Only the line feed of a CR LF is skipped
+    send("watch hw/pot\r\n");
+    EXPECT_THAT(_ioStream.getOutput(), testing::HasSubstr("Every 2s: hw/pot"));
+    send("\n");
+    EXPECT_THAT(_ioStream.getOutput(), testing::EndsWith("user@/> "));
+
+    // Bare LF and bare CR terminals stop it with their first Enter
+    for (const std::string enter : {"\n", "\r"})
+    {
+      _ioStream.clearOutput();
+      send("watch hw/pot" + enter);
+      EXPECT_THAT(_ioStream.getOutput(), testing::HasSubstr("Every 2s: hw/pot"));
+
+      _ioStream.clearOutput();
+      send(enter);
+      EXPECT_THAT(_ioStream.getOutput(), testing::EndsWith("user@/> ")) << "Enter " << int(enter[0]);
+    }
+  }
+
+}
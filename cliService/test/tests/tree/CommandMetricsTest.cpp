@@ -0,0 +1,56 @@
+#include "gtest/gtest.h"
+#include "cliService/tree/CommandMetrics.hpp"
+
+namespace cliService
+{
+
+  TEST(CommandMetricsTest, BucketIndexIsLog2)
+  {
+    EXPECT_EQ(CommandMetrics::getBucketIndex(0), 0u);
+    EXPECT_EQ(CommandMetrics::getBucketIndex(1), 0u);
+    EXPECT_EQ(CommandMetrics::getBucketIndex(2), 1u);
+    EXPECT_EQ(CommandMetrics::getBucketIndex(3), 1u);
+    EXPECT_EQ(CommandMetrics::getBucketIndex(4), 2u);
+    EXPECT_EQ(CommandMetrics::getBucketIndex(1023), 9u);
+    EXPECT_EQ(CommandMetrics::getBucketIndex(1024), 10u);
+    EXPECT_EQ(CommandMetrics::getBucketIndex(UINT64_MAX), CommandMetrics::BUCKET_COUNT - 1);
+  }
+
+  TEST(CommandMetricsTest, RecordCountsInvocationsAndErrors)
+  {
+    CommandMetrics metrics;
+    metrics.record(10, false);
+    metrics.record(30, true);
+    metrics.record(20, false);
+
+    EXPECT_EQ(metrics.getInvocations(), 3u);
+    EXPECT_EQ(metrics.getErrors(), 1u);
+    EXPECT_EQ(metrics.getTotalLatency_us(), 60u);
+    EXPECT_EQ(metrics.getAverageLatency_us(), 20u);
+    EXPECT_EQ(metrics.getMaxLatency_us(), 30u);
+    EXPECT_EQ(metrics.getBucketCount(3), 1u);  // 10 in [8, 16)
+    EXPECT_EQ(metrics.getBucketCount(4), 2u);  // 20 and 30 in [16, 32)
+
+    metrics.reset();
+    EXPECT_EQ(metrics.getInvocations(), 0u);
+    EXPECT_EQ(metrics.getBucketCount(4), 0u);
+    EXPECT_EQ(metrics.getAverageLatency_us(), 0u);
+  }
+
+  TEST(CommandMetricsTest, PercentilesUseBucketUpperBounds)
+  {
+    CommandMetrics metrics;
+    EXPECT_EQ(metrics.getPercentileLatency_us(50), 0u);
+
+    for (int i = 0; i < 98; ++i) {
+      metrics.record(5, false);      // [4, 8)
+    }
+    metrics.record(100, false);      // [64, 128)
+    metrics.record(3000, false);     // [2048, 4096)
+
+    EXPECT_EQ(metrics.getPercentileLatency_us(50), 7u);
+    EXPECT_EQ(metrics.getPercentileLatency_us(99), 127u);
+    EXPECT_EQ(metrics.getPercentileLatency_us(100), 3000u);  // Capped at the maximum
+  }
+
+}
@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+#include "cliService/tree/ConstTree.hpp"
+
+namespace cliService
+{
+  enum class AccessLevel
+  {
+    User,
+    Admin
+  };
+
+  namespace
+  {
+    CLIResponse echoArgs(const std::vector<std::string>& args)
+    {
+      std::string msg;
+      for (const auto& arg : args) { msg += arg; }
+      return CLIResponse::success(msg);
+    }
+
+    CLIResponse rebootCmd(const std::vector<std::string>&) {
+      return CLIResponse::success(std::string("rebooting"));
+    }
+
+    // root/
+    // ├── system/   (Admin)
+    // │   └── reboot
+    // ├── hw/
+    // │   └── rgb/
+    // │       └── set
+    // └── echo
+    constexpr ConstNode NODES[] = {
+      ConstTree::directory("root",   AccessLevel::User,  ConstTree::INVALID, 1, 3),
+      ConstTree::directory("system", AccessLevel::Admin, 0, 4, 1),
+      ConstTree::directory("hw",     AccessLevel::User,  0, 5, 1),
+      ConstTree::command("echo",     AccessLevel::User,  0, &echoArgs, "Echo arguments"),
+      ConstTree::command("reboot",   AccessLevel::User,  1, &rebootCmd),
+      ConstTree::directory("rgb",    AccessLevel::User,  2, 6, 1),
+      ConstTree::command("set",      AccessLevel::Admin, 5, &echoArgs),
+    };
+
+    constexpr ConstTree TREE{NODES};
+
+    // Lookups are usable in constant expressions
+    static_assert(TREE.isValid());
+    static_assert(TREE.resolve("/hw/rgb/set") == 6);
+    static_assert(TREE.resolve("hw/../system/reboot") == 4);
+    static_assert(TREE.resolve("/nonexistent") == ConstTree::INVALID);
+  }
+
+  TEST(ConstTreeTest, ResolveAbsolutePaths)
+  {
+    EXPECT_EQ(TREE.resolve("/"), ConstTree::ROOT);
+    EXPECT_EQ(TREE.resolve(""), ConstTree::ROOT);
+    EXPECT_EQ(TREE.resolve("/system"), 1);
+    EXPECT_EQ(TREE.resolve("/system/reboot"), 4);
+    EXPECT_EQ(TREE.resolve("//hw//rgb/"), 5);
+  }
+
+  TEST(ConstTreeTest, ResolveRelativePaths)
+  {
+    EXPECT_EQ(TREE.resolve("rgb/set", 2), 6);
+    EXPECT_EQ(TREE.resolve("..", 5), 2);
+    EXPECT_EQ(TREE.resolve("./set", 5), 6);
+    EXPECT_EQ(TREE.resolve("../../echo", 5), 3);
+    EXPECT_EQ(TREE.resolve("/echo", 5), 3);
+  }
+
+  TEST(ConstTreeTest, ParentOfRootIsRoot)
+  {
+    EXPECT_EQ(TREE.resolve("../../.."), ConstTree::ROOT);
+    EXPECT_EQ(TREE.resolve("/../hw"), 2);
+  }
+
+  TEST(ConstTreeTest, InvalidPaths)
+  {
+    EXPECT_EQ(TREE.resolve("/missing"), ConstTree::INVALID);
+    EXPECT_EQ(TREE.resolve("/echo/child"), ConstTree::INVALID);
+    EXPECT_EQ(TREE.resolve("hw."), ConstTree::INVALID);
+  }
+
+  TEST(ConstTreeTest, InvalidIndicesAreRejected)
+  {
+    // Results of a failed resolve() passed on unchecked
+    EXPECT_EQ(TREE.resolve("set", ConstTree::INVALID), ConstTree::INVALID);
+    EXPECT_EQ(TREE.resolve("..", static_cast<ConstNodeIndex>(TREE.size())), ConstTree::INVALID);
+    EXPECT_EQ(TREE.resolve("/hw", ConstTree::INVALID), 2);
+    EXPECT_EQ(TREE.findChild(ConstTree::INVALID, "hw"), ConstTree::INVALID);
+    EXPECT_FALSE(TREE.isAccessible(ConstTree::INVALID, AccessLevel::Admin));
+    EXPECT_EQ(TREE.getAbsolutePath(ConstTree::INVALID), "");
+  }
+
+  TEST(ConstTreeTest, AccessLevelIncludesAncestors)
+  {
+    EXPECT_TRUE(TREE.isAccessible(3, AccessLevel::User));
+    EXPECT_FALSE(TREE.isAccessible(1, AccessLevel::User));
+    EXPECT_FALSE(TREE.isAccessible(4, AccessLevel::User));  // User command inside Admin directory
+    EXPECT_TRUE(TREE.isAccessible(4, AccessLevel::Admin));
+    EXPECT_FALSE(TREE.isAccessible(6, AccessLevel::User));
+  }
+
+  TEST(ConstTreeTest, AbsolutePath)
+  {
+    EXPECT_EQ(TREE.getAbsolutePath(ConstTree::ROOT), "/");
+    EXPECT_EQ(TREE.getAbsolutePath(6), "/hw/rgb/set");
+    EXPECT_EQ(TREE.getAbsolutePath(1), "/system");
+  }
+
+  TEST(ConstTreeTest, ExecuteCommand)
+  {
+    auto response = TREE.execute(TREE.resolve("/echo"), {"a", "b"});
+    EXPECT_EQ(response.getStatus(), CLIResponse::Status::Success);
+    EXPECT_EQ(response.getMessage(), "ab");
+
+    response = TREE.execute(TREE.resolve("/system/reboot"), {});
+    EXPECT_EQ(response.getMessage(), "rebooting");
+  }
+
+  TEST(ConstTreeTest, ExecuteDirectoryFails)
+  {
+    auto response = TREE.execute(TREE.resolve("/hw"), {});
+    EXPECT_EQ(response.getStatus(), CLIResponse::Status::InvalidPath);
+
+    response = TREE.execute(ConstTree::INVALID, {});
+    EXPECT_EQ(response.getStatus(), CLIResponse::Status::InvalidPath);
+  }
+
+  TEST(ConstTreeTest, DetectsMalformedTables)
+  {
+    static constexpr ConstNode wrongParent[] = {
+      ConstTree::directory("root", AccessLevel::User, ConstTree::INVALID, 1, 1),
+      ConstTree::command("cmd", AccessLevel::User, 5, &echoArgs),
+    };
+
+    static constexpr ConstNode collision[] = {
+      ConstTree::directory("root", AccessLevel::User, ConstTree::INVALID, 1, 2),
+      ConstTree::command("cmd", AccessLevel::User, 0, &echoArgs),
+      ConstTree::command("cmd", AccessLevel::User, 0, &echoArgs),
+    };
+
+    static constexpr ConstNode childOutOfRange[] = {
+      ConstTree::directory("root", AccessLevel::User, ConstTree::INVALID, 1, 4),
+      ConstTree::command("cmd", AccessLevel::User, 0, &echoArgs),
+    };
+
+    EXPECT_FALSE(ConstTree(wrongParent).isValid());
+    EXPECT_FALSE(ConstTree(collision).isValid());
+    EXPECT_FALSE(ConstTree(childOutOfRange).isValid());
+  }
+
+}
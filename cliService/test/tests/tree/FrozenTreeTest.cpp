@@ -0,0 +1,225 @@
+#include <gtest/gtest.h>
+#include "cliService/tree/Directory.hpp"
+#include "cliService/tree/FrozenTree.hpp"
+#include "cliService/tree/PathCompleter.hpp"
+#include "cliService/tree/PathResolver.hpp"
+
+namespace cliService
+{
+  enum class AccessLevel
+  {
+    User,
+    Admin
+  };
+
+  class TestCommand : public CommandIf
+  {
+  public:
+    TestCommand(std::string name, AccessLevel level, std::string description = "")
+      : CommandIf(std::move(name), level, std::move(description))
+    {}
+
+    CLIResponse execute(const std::vector<std::string>&) override {
+      return CLIResponse::success();
+    }
+  };
+
+  class FrozenTreeTest : public ::testing::Test
+  {
+  protected:
+    void SetUp() override
+    {
+      // root/
+      // ├── system/     (Admin)
+      // │   ├── reboot
+      // │   └── heap
+      // ├── hw/
+      // │   ├── pot/
+      // │   │   └── get
+      // │   └── rgb/
+      // │       └── set (Admin)
+      // └── version
+      root = std::make_unique<Directory>("root", AccessLevel::User);
+
+      auto& system = root->addDynamicDirectory("system", AccessLevel::Admin);
+      system.addDynamicCommand<TestCommand>("reboot", AccessLevel::Admin);
+      system.addDynamicCommand<TestCommand>("heap", AccessLevel::Admin);
+
+      hw = &root->addDynamicDirectory("hw", AccessLevel::User);
+      pot = &hw->addDynamicDirectory("pot", AccessLevel::User);
+      pot->addDynamicCommand<TestCommand>("get", AccessLevel::User);
+      auto& rgb = hw->addDynamicDirectory("rgb", AccessLevel::User);
+      rgb.addDynamicCommand<TestCommand>("set", AccessLevel::Admin);
+
+      root->addDynamicCommand<TestCommand>("version", AccessLevel::User);
+    }
+
+    std::vector<std::pair<std::string, size_t>> traverseAll(const Directory& dir) const
+    {
+      std::vector<std::pair<std::string, size_t>> visited;
+      dir.traverse([&visited](const NodeIf& node, size_t depth) {
+        visited.emplace_back(node.getName(), depth);
+      });
+      return visited;
+    }
+
+    std::unique_ptr<Directory> root;
+    Directory* hw;
+    Directory* pot;
+  };
+
+  TEST_F(FrozenTreeTest, FreezeState)
+  {
+    EXPECT_FALSE(root->isFrozen());
+    EXPECT_EQ(root->findFrozenTree(), nullptr);
+
+    root->freeze();
+
+    EXPECT_TRUE(root->isFrozen());
+    EXPECT_EQ(root->findFrozenTree(), root->getFrozenTree());
+    EXPECT_EQ(pot->findFrozenTree(), root->getFrozenTree());
+  }
+
+  TEST_F(FrozenTreeTest, BreadthFirstLayoutWithContiguousChildren)
+  {
+    FrozenTree tree(*root);
+
+    ASSERT_EQ(tree.size(), 10u);
+    EXPECT_EQ(tree.getName(FrozenTree::ROOT), "root");
+    EXPECT_EQ(tree.getParent(FrozenTree::ROOT), FrozenTree::INVALID);
+
+    // Root children in insertion order
+    ASSERT_EQ(tree.getChildCount(FrozenTree::ROOT), 3u);
+    FrozenTree::Index first = tree.getFirstChild(FrozenTree::ROOT);
+    EXPECT_EQ(tree.getName(first), "system");
+    EXPECT_EQ(tree.getName(first + 1), "hw");
+    EXPECT_EQ(tree.getName(first + 2), "version");
+    EXPECT_FALSE(tree.isDirectory(first + 2));
+
+    // Every child points back at its parent
+    for (FrozenTree::Index i = 0; i < tree.size(); ++i)
+    {
+      for (FrozenTree::Index c = 0; c < tree.getChildCount(i); ++c) {
+        EXPECT_EQ(tree.getParent(tree.getFirstChild(i) + c), i);
+      }
+
+      EXPECT_EQ(tree.indexOf(*tree.getNode(i)), i);
+      EXPECT_EQ(tree.getName(i), tree.getNode(i)->getName());
+      EXPECT_EQ(tree.getEffectiveAccessLevel(i), tree.getNode(i)->getEffectiveAccessLevel());
+    }
+  }
+
+  TEST_F(FrozenTreeTest, IndexOfForeignNode)
+  {
+    FrozenTree tree(*root);
+    Directory other("other", AccessLevel::User);
+    EXPECT_EQ(tree.indexOf(other), FrozenTree::INVALID);
+  }
+
+  TEST_F(FrozenTreeTest, ResolveMatchesPointerTree)
+  {
+    const std::vector<std::string> paths = {
+      "", "/", ".", "..", "/hw", "hw/pot/get", "/hw/rgb/set", "/hw/rgb/../pot/get",
+      "/missing/../hw", "/version/..", "/version/x", "/version/x/..", "../../hw",
+      "//hw//pot//", "hw./pot", "/system/reboot", "pot/get", "../rgb", "./get"
+    };
+
+    PathResolver resolver(*root);
+    std::vector<const Directory*> startDirs = {root.get(), hw, pot};
+
+    std::vector<NodeIf*> expected;
+    for (const auto* start : startDirs) {
+      for (const auto& path : paths) {
+        expected.push_back(resolver.resolve(Path(path), *start));
+      }
+    }
+
+    root->freeze();
+
+    size_t i = 0;
+    for (const auto* start : startDirs) {
+      for (const auto& path : paths) {
+        EXPECT_EQ(resolver.resolve(Path(path), *start), expected[i++]) << "path: " << path;
+      }
+    }
+  }
+
+  TEST_F(FrozenTreeTest, TraverseMatchesPointerTree)
+  {
+    auto expectedRoot = traverseAll(*root);
+    auto expectedHw = traverseAll(*hw);
+
+    root->freeze();
+
+    EXPECT_EQ(traverseAll(*root), expectedRoot);
+    EXPECT_EQ(traverseAll(*hw), expectedHw);
+  }
+
+  TEST_F(FrozenTreeTest, CompletionMatchesPointerTree)
+  {
+    const std::vector<std::string> inputs = {
+      "", "h", "hw/", "hw/p", "/hw/rgb/", "/s", "../", "../../h", "ver", "version/", "x", "hw/pot/g"
+    };
+
+    auto completeAll = [&](const Directory& dir, AccessLevel level) {
+      std::vector<PathCompleter::CompletionResult> results;
+      for (const auto& input : inputs) {
+        results.push_back(PathCompleter::complete(dir, input, level));
+      }
+      return results;
+    };
+
+    auto expectedUser = completeAll(*root, AccessLevel::User);
+    auto expectedAdmin = completeAll(*hw, AccessLevel::Admin);
+
+    root->freeze();
+
+    auto frozenUser = completeAll(*root, AccessLevel::User);
+    auto frozenAdmin = completeAll(*hw, AccessLevel::Admin);
+
+    for (size_t i = 0; i < inputs.size(); ++i)
+    {
+      EXPECT_EQ(frozenUser[i].allOptions, expectedUser[i].allOptions) << inputs[i];
+      EXPECT_EQ(frozenUser[i].fullPath, expectedUser[i].fullPath) << inputs[i];
+      EXPECT_EQ(frozenUser[i].fillCharacters, expectedUser[i].fillCharacters) << inputs[i];
+      EXPECT_EQ(frozenAdmin[i].allOptions, expectedAdmin[i].allOptions) << inputs[i];
+      EXPECT_EQ(frozenAdmin[i].fullPath, expectedAdmin[i].fullPath) << inputs[i];
+      EXPECT_EQ(frozenAdmin[i].fillCharacters, expectedAdmin[i].fillCharacters) << inputs[i];
+    }
+  }
+
+  TEST_F(FrozenTreeTest, MutationDiscardsSnapshot)
+  {
+    root->freeze();
+    ASSERT_TRUE(root->isFrozen());
+
+    auto& cmd = pot->addDynamicCommand<TestCommand>("set", AccessLevel::User);
+
+    EXPECT_FALSE(root->isFrozen());
+    EXPECT_EQ(pot->findFrozenTree(), nullptr);
+
+    // New node is reachable through the regular path again
+    PathResolver resolver(*root);
+    EXPECT_EQ(resolver.resolve(Path("/hw/pot/set"), *root), &cmd);
+
+    // ... and after re-freezing
+    root->freeze();
+    EXPECT_EQ(resolver.resolve(Path("/hw/pot/set"), *root), &cmd);
+  }
+
+  TEST_F(FrozenTreeTest, FrozenSubtreeTraversal)
+  {
+    auto expected = traverseAll(*hw);
+
+    hw->freeze();
+
+    EXPECT_FALSE(root->isFrozen());
+    EXPECT_EQ(pot->findFrozenTree(), hw->getFrozenTree());
+    EXPECT_EQ(traverseAll(*hw), expected);
+
+    // Subtree snapshots are not used for resolution from the real root
+    PathResolver resolver(*root);
+    EXPECT_EQ(resolver.resolve(Path("../system"), *hw), root->findNode({"system"}));
+  }
+
+}
@@ -0,0 +1,217 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "cliService/cli/CLIService.hpp"
+#include "cliService/tree/PathCompleter.hpp"
+#include "cliService/tree/PathResolver.hpp"
+#include "generator/TreeGenerator.hpp"
+#include "mock/command/CommandMock.hpp"
+#include "mock/io/CharIOStreamMock.hpp"
+
+namespace cliService
+{
+
+  class LargeTreeTest : public ::testing::Test
+  {
+  protected:
+    static TreeGeneratorConfig stressConfig()
+    {
+      // 1 + 15 + 225 + 3375 + 50625 = 54241 nodes
+      TreeGeneratorConfig config;
+      config.depth = 4;
+      config.fanOut = 15;
+      config.commandRatio = 0.0;
+      config.minNameLength = 2;
+      config.maxNameLength = 10;
+      config.publicLevel = AccessLevel::User;
+      config.restrictedLevel = AccessLevel::Admin;
+      config.restrictedRatio = 0.2;
+      return config;
+    }
+
+    static std::vector<const NodeIf*> collectNodes(const Directory& root)
+    {
+      std::vector<const NodeIf*> nodes;
+      root.visit([&](const NodeIf& node, size_t) { nodes.push_back(&node); });
+      return nodes;
+    }
+
+    static std::string absolutePath(const NodeIf& node)
+    {
+      return PathResolver::getAbsolutePath(node).toString();
+    }
+  };
+
+  TEST_F(LargeTreeTest, GeneratorIsDeterministic)
+  {
+    auto config = stressConfig();
+    config.depth = 3;
+
+    TreeGenerator first(config);
+    TreeGenerator second(config);
+    auto firstRoot = first.generate();
+    auto secondRoot = second.generate();
+
+    auto firstNodes = collectNodes(*firstRoot);
+    auto secondNodes = collectNodes(*secondRoot);
+
+    ASSERT_EQ(firstNodes.size(), secondNodes.size());
+    for (size_t i = 0; i < firstNodes.size(); ++i)
+    {
+      EXPECT_EQ(firstNodes[i]->getName(), secondNodes[i]->getName());
+      EXPECT_EQ(firstNodes[i]->getAccessLevel(), secondNodes[i]->getAccessLevel());
+    }
+  }
+
+  TEST_F(LargeTreeTest, GeneratorHonoursShape)
+  {
+    auto config = stressConfig();
+    config.depth = 3;
+    config.fanOut = 6;
+
+    TreeGenerator generator(config);
+    auto root = generator.generate();
+    const auto& stats = generator.getStats();
+
+    EXPECT_EQ(stats.nodeCount, TreeGenerator::upperBoundNodeCount(config));
+    EXPECT_EQ(stats.nodeCount, collectNodes(*root).size());
+    EXPECT_EQ(stats.commandCount, 6u * 6u * 6u);
+    EXPECT_EQ(stats.maxDepth, 3u);
+    EXPECT_GT(stats.restrictedCount, 0u);
+    EXPECT_LT(stats.restrictedCount, stats.nodeCount);
+
+    for (const auto* node : collectNodes(*root))
+    {
+      if (node == root.get()) { continue; }
+      EXPECT_GE(node->getName().size(), config.minNameLength);
+      EXPECT_EQ(node->getName().find('/'), std::string::npos);
+    }
+  }
+
+  TEST_F(LargeTreeTest, GeneratorStopsAtMaxNodes)
+  {
+    auto config = stressConfig();
+    config.maxNodes = 1000;
+
+    TreeGenerator generator(config);
+    auto root = generator.generate();
+
+    EXPECT_EQ(generator.getStats().nodeCount, 1000u);
+    EXPECT_EQ(collectNodes(*root).size(), 1000u);
+  }
+
+  TEST_F(LargeTreeTest, ShortNamesStayUnique)
+  {
+    auto config = stressConfig();
+    config.depth = 1;
+    config.fanOut = 200;
+    config.minNameLength = 1;
+    config.maxNameLength = 1;
+
+    // Duplicate names would trip Directory's collision check
+    TreeGenerator generator(config);
+    auto root = generator.generate();
+
+    EXPECT_EQ(generator.getStats().nodeCount, 201u);
+  }
+
+  TEST_F(LargeTreeTest, EveryNodeResolvesInPointerAndFrozenTree)
+  {
+    TreeGenerator generator(stressConfig());
+    auto root = generator.generate();
+    auto nodes = collectNodes(*root);
+    ASSERT_EQ(nodes.size(), 54241u);
+
+    std::vector<std::string> paths;
+    paths.reserve(nodes.size());
+    for (const auto* node : nodes) { paths.push_back(absolutePath(*node)); }
+
+    PathResolver resolver(*root);
+
+    for (size_t i = 0; i < nodes.size(); ++i) {
+      ASSERT_EQ(resolver.resolveFromString(paths[i], *root), nodes[i]) << paths[i];
+    }
+
+    root->freeze();
+    ASSERT_EQ(root->getFrozenTree()->size(), nodes.size());
+
+    for (size_t i = 0; i < nodes.size(); ++i) {
+      ASSERT_EQ(resolver.resolveFromString(paths[i], *root), nodes[i]) << paths[i];
+    }
+  }
+
+  TEST_F(LargeTreeTest, EffectiveAccessLevelsAreMonotonic)
+  {
+    TreeGenerator generator(stressConfig());
+    auto root = generator.generate();
+
+    for (const auto* node : collectNodes(*root))
+    {
+      const auto* parent = node->getParent();
+      if (!parent) { continue; }
+
+      EXPECT_GE(node->getEffectiveAccessLevel(), parent->getEffectiveAccessLevel());
+      EXPECT_GE(node->getEffectiveAccessLevel(), node->getAccessLevel());
+    }
+  }
+
+  TEST_F(LargeTreeTest, CompletionHidesRestrictedNodes)
+  {
+    TreeGenerator generator(stressConfig());
+    auto root = generator.generate();
+
+    size_t checkedDirectories = 0;
+
+    root->visit([&](const NodeIf& node, size_t depth) {
+      if (!node.isDirectory() || depth > 2) { return TraversalAction::SkipChildren; }
+
+      const auto& dir = static_cast<const Directory&>(node);
+      auto userOptions = PathCompleter::complete(dir, "", AccessLevel::User).allOptions;
+      auto adminOptions = PathCompleter::complete(dir, "", AccessLevel::Admin).allOptions;
+
+      size_t visibleToUser = 0;
+      dir.visit([&](const NodeIf& child, size_t childDepth) {
+        if (childDepth == 0) { return TraversalAction::Continue; }
+        if (child.getEffectiveAccessLevel() <= AccessLevel::User) { visibleToUser++; }
+        return TraversalAction::SkipChildren;
+      });
+
+      EXPECT_EQ(userOptions.size(), visibleToUser);
+      EXPECT_EQ(adminOptions.size(), 15u);
+      checkedDirectories++;
+
+      return TraversalAction::Continue;
+    });
+
+    EXPECT_GT(checkedDirectories, 1u);
+  }
+
+  TEST_F(LargeTreeTest, ServiceExecutesDeepCommands)
+  {
+    auto config = stressConfig();
+    config.restrictedRatio = 0.0;
+    TreeGenerator generator(config);
+    auto root = generator.generate();
+    root->freeze();
+
+    std::vector<User> users = {{"user", "user123", AccessLevel::User}};
+    CharIOStreamMock ioStream;
+    CLIService service(CLIServiceConfiguration{ioStream, users, *root, 1000, 10});
+    service.activate();
+    ioStream.queueInput("user:user123\n");
+    service.service();
+
+    // Every 997th command, spread over the whole tree
+    auto nodes = collectNodes(*root);
+    for (size_t i = 0; i < nodes.size(); i += 997)
+    {
+      if (nodes[i]->isDirectory()) { continue; }
+
+      ioStream.clearOutput();
+      ioStream.queueInput(absolutePath(*nodes[i]) + "\n");
+      service.service();
+
+      EXPECT_THAT(ioStream.getOutput(), testing::HasSubstr(nodes[i]->getName()));
+    }
+  }
+
+}
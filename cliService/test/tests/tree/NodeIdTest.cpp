@@ -0,0 +1,90 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "cliService/cli/CLIService.hpp"
+#include "cliService/tree/Directory.hpp"
+#include "mock/command/CommandMock.hpp"
+#include "mock/io/CharIOStreamMock.hpp"
+
+namespace cliService
+{
+
+  TEST(NodeIdTest, AssignedWhenAddedAndLookedUpById)
+  {
+    Directory root("root", AccessLevel::User);
+    auto& hw = root.addDynamicDirectory("hw", AccessLevel::User);
+    auto& set = hw.addDynamicCommand<CommandMock>("set", AccessLevel::User);
+    auto& ping = root.addDynamicCommand<CommandMock>("ping", AccessLevel::User);
+
+    EXPECT_EQ(root.getId(), NodeIf::ROOT_ID);
+    EXPECT_EQ(hw.getId(), 1u);
+    EXPECT_EQ(set.getId(), 2u);
+    EXPECT_EQ(ping.getId(), 3u);
+
+    EXPECT_EQ(root.findNodeById(0), &root);
+    EXPECT_EQ(root.findNodeById(2), &set);
+    EXPECT_EQ(root.findNodeById(3), &ping);
+    EXPECT_EQ(root.findNodeById(4), nullptr);
+    EXPECT_EQ(root.findNodeById(NodeIf::INVALID_ID), nullptr);
+  }
+
+  TEST(NodeIdTest, StableWhenTheTreeGrows)
+  {
+    Directory root("root", AccessLevel::User);
+    auto& a = root.addDynamicDirectory("a", AccessLevel::User);
+    auto& b = root.addDynamicCommand<CommandMock>("b", AccessLevel::User);
+
+    // Inserted before 'b' in traversal order, but IDs are never shifted
+    auto& c = a.addDynamicCommand<CommandMock>("c", AccessLevel::User);
+
+    EXPECT_EQ(b.getId(), 2u);
+    EXPECT_EQ(c.getId(), 3u);
+    EXPECT_EQ(root.findNodeById(b.getId()), &b);
+  }
+
+  TEST(NodeIdTest, SubtreeRenumberedWhenAdded)
+  {
+    Directory sub("sub", AccessLevel::User);
+    CommandMock x("x", AccessLevel::User);
+    CommandMock y("y", AccessLevel::User);
+    sub.addStaticCommand(x);
+    sub.addStaticCommand(y);
+    EXPECT_EQ(sub.findNodeById(2), &y);
+
+    Directory root("root", AccessLevel::User);
+    root.addDynamicCommand<CommandMock>("first", AccessLevel::User);
+    root.addStaticDirectory(sub);
+
+    EXPECT_EQ(sub.getId(), 2u);
+    EXPECT_EQ(x.getId(), 3u);
+    EXPECT_EQ(y.getId(), 4u);
+    EXPECT_EQ(root.findNodeById(4), &y);
+
+    // Only the root holds the table
+    EXPECT_EQ(sub.findNodeById(2), nullptr);
+  }
+
+  TEST(NodeIdTest, RequestsReferenceNodesById)
+  {
+    auto root = std::make_unique<Directory>("root", AccessLevel::User);
+    auto& hw = root->addDynamicDirectory("hw", AccessLevel::User);
+    auto& set = hw.addDynamicCommand<CommandMock>("set", AccessLevel::User);
+    root->addDynamicCommand<CommandMock>("secret", AccessLevel::Admin);
+
+    EXPECT_CALL(set, execute(std::vector<std::string>{"1", "2"}))
+      .WillOnce(testing::Return(CLIResponse::success(std::string("set done"))));
+
+    CharIOStreamMock ioStream;
+    CLIService service(CLIServiceConfiguration{ioStream, {{"user", "user123", AccessLevel::User}}, std::move(root), 1000, 10});
+    service.activate();
+
+    ioStream.queueInput("user:user123\n@2 1 2\n@1\n@3\n@9\n@x\n");
+    for (int i = 0; i < 6; ++i) { service.service(); }
+
+    const std::string output = ioStream.getOutput();
+    EXPECT_THAT(output, testing::HasSubstr("set done"));
+    EXPECT_THAT(output, testing::HasSubstr("user@/hw> "));
+    EXPECT_THAT(output, testing::HasSubstr(CLIMessages::getDefaults().getAccessDeniedMessage()));
+    EXPECT_THAT(output, testing::EndsWith(std::string(CLIMessages::getDefaults().getInvalidPathMessage()) + "\r\n\r\nuser@/hw> "));
+  }
+
+}
@@ -0,0 +1,116 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "cliService/tree/OutputFilter.hpp"
+
+namespace cliService
+{
+
+  class OutputFilterTest : public ::testing::Test
+  {
+  protected:
+    // Numbered lines "line 1" ... "line N", counting how many were pulled
+    std::shared_ptr<OutputSourceIf> numberedLines(size_t count)
+    {
+      _pulled = 0;
+      return std::make_shared<CallbackOutputSource>([this, count](std::string& line) {
+        if (_pulled == count) { return false; }
+        line = "line " + std::to_string(++_pulled);
+        return true;
+      });
+    }
+
+    static std::vector<std::string> run(const std::vector<std::string>& words, std::shared_ptr<OutputSourceIf> source)
+    {
+      auto filter = OutputFilter::parse(words);
+      EXPECT_TRUE(filter.has_value());
+      if (!filter) { return {}; }
+
+      auto filtered = filter->apply(std::move(source));
+
+      std::vector<std::string> lines;
+      std::string line;
+
+      while (filtered->nextLine(line)) {
+        lines.push_back(line);
+      }
+
+      return lines;
+    }
+
+    size_t _pulled = 0;
+  };
+
+  TEST_F(OutputFilterTest, Parse)
+  {
+    auto grep = OutputFilter::parse({"grep", "rgb", "led"});
+    ASSERT_TRUE(grep.has_value());
+    EXPECT_EQ(grep->getKind(), OutputFilter::Kind::Grep);
+    EXPECT_EQ(grep->getPattern(), "rgb led");
+
+    auto head = OutputFilter::parse({"head"});
+    ASSERT_TRUE(head.has_value());
+    EXPECT_EQ(head->getLineCount(), OutputFilter::DEFAULT_LINE_COUNT);
+
+    auto tail = OutputFilter::parse({"tail", "3"});
+    ASSERT_TRUE(tail.has_value());
+    EXPECT_EQ(tail->getKind(), OutputFilter::Kind::Tail);
+    EXPECT_EQ(tail->getLineCount(), 3u);
+
+    const std::vector<std::vector<std::string>> invalid = {
+      {},
+      {"grep"},
+      {"grep", "-v"},
+      {"head", "x"},
+      {"head", "1", "2"},
+      {"tail", std::to_string(OutputFilter::MAX_TAIL_LINES + 1)},
+      {"count", "1"},
+      {"sort"}
+    };
+
+    for (const auto& words : invalid) {
+      EXPECT_FALSE(OutputFilter::parse(words).has_value()) << testing::PrintToString(words);
+    }
+  }
+
+  TEST_F(OutputFilterTest, Grep)
+  {
+    EXPECT_EQ(run({"grep", "1"}, numberedLines(12)), (std::vector<std::string>{"line 1", "line 10", "line 11", "line 12"}));
+    EXPECT_EQ(run({"grep", "-v", "line"}, numberedLines(3)), std::vector<std::string>{});
+  }
+
+  TEST_F(OutputFilterTest, HeadStopsPullingEarly)
+  {
+    EXPECT_EQ(run({"head", "2"}, numberedLines(1000)), (std::vector<std::string>{"line 1", "line 2"}));
+    EXPECT_EQ(_pulled, 2u);
+  }
+
+  TEST_F(OutputFilterTest, TailKeepsLastLines)
+  {
+    EXPECT_EQ(run({"tail", "3"}, numberedLines(8)), (std::vector<std::string>{"line 6", "line 7", "line 8"}));
+
+    // Fewer lines than requested
+    EXPECT_EQ(run({"tail", "5"}, numberedLines(2)), (std::vector<std::string>{"line 1", "line 2"}));
+    EXPECT_EQ(run({"tail", "0"}, numberedLines(2)), std::vector<std::string>{});
+  }
+
+  TEST_F(OutputFilterTest, Count)
+  {
+    EXPECT_EQ(run({"count"}, numberedLines(42)), std::vector<std::string>{"42"});
+    EXPECT_EQ(run({"count"}, numberedLines(0)), std::vector<std::string>{"0"});
+  }
+
+  TEST_F(OutputFilterTest, MessageLinesComeBeforeStreamedLines)
+  {
+    auto source = std::make_shared<MessageLineSource>("a\r\n\r\nb\r\n", "\r\n", numberedLines(1));
+
+    std::vector<std::string> lines;
+    std::string line;
+
+    while (source->nextLine(line)) {
+      lines.push_back(line);
+    }
+
+    EXPECT_EQ(lines, (std::vector<std::string>{"a", "", "b", "line 1"}));
+  }
+
+}
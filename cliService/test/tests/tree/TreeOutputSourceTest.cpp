@@ -0,0 +1,98 @@
+#include "gtest/gtest.h"
+#include "cliService/tree/Directory.hpp"
+#include "cliService/tree/TreeOutputSource.hpp"
+#include "mock/command/CommandMock.hpp"
+
+namespace cliService
+{
+
+  class TreeOutputSourceTest : public ::testing::Test
+  {
+  protected:
+    void SetUp() override
+    {
+      // root/
+      // ├── admin/ (Admin)
+      // │   └── config
+      // ├── public/
+      // │   ├── nested/
+      // │   │   └── deep
+      // │   └── info - Public info
+      // └── ping
+      root = std::make_unique<Directory>("root", AccessLevel::User);
+      auto& admin = root->addDynamicDirectory("admin", AccessLevel::Admin);
+      admin.addDynamicCommand<CommandMock>("config", AccessLevel::User);
+      publicDir = &root->addDynamicDirectory("public", AccessLevel::User);
+      auto& nested = publicDir->addDynamicDirectory("nested", AccessLevel::User);
+      nested.addDynamicCommand<CommandMock>("deep", AccessLevel::User);
+      publicDir->addDynamicCommand<CommandMock>("info", AccessLevel::User, "Public info");
+      root->addDynamicCommand<CommandMock>("ping", AccessLevel::User);
+    }
+
+    static std::vector<std::string> drain(OutputSourceIf& source)
+    {
+      std::vector<std::string> lines;
+      std::string line = "stale";
+      while (source.nextLine(line)) { lines.push_back(line); }
+      return lines;
+    }
+
+    std::unique_ptr<Directory> root;
+    Directory* publicDir;
+  };
+
+  TEST_F(TreeOutputSourceTest, RendersIndentedPreOrder)
+  {
+    TreeOutputSource source(*root, AccessLevel::Admin);
+
+    EXPECT_EQ(drain(source), (std::vector<std::string>{
+      "root/",
+      "  admin/",
+      "    config",
+      "  public/",
+      "    nested/",
+      "      deep",
+      "    info",
+      "  ping"
+    }));
+
+    std::string line;
+    EXPECT_FALSE(source.nextLine(line));
+  }
+
+  TEST_F(TreeOutputSourceTest, HidesInaccessibleSubtrees)
+  {
+    TreeOutputSource source(*root, AccessLevel::User);
+
+    EXPECT_EQ(drain(source), (std::vector<std::string>{
+      "root/", "  public/", "    nested/", "      deep", "    info", "  ping"
+    }));
+  }
+
+  TEST_F(TreeOutputSourceTest, StartsAtGivenDirectoryWithDescriptions)
+  {
+    TreeOutputSource source(*publicDir, AccessLevel::User, true);
+
+    EXPECT_EQ(drain(source), (std::vector<std::string>{
+      "public/", "  nested/", "    deep", "  info - Public info"
+    }));
+  }
+
+  TEST_F(TreeOutputSourceTest, LimitsDepth)
+  {
+    TreeOutputSource depthZero(*root, AccessLevel::User, false, 0);
+    EXPECT_EQ(drain(depthZero), (std::vector<std::string>{"root/"}));
+
+    TreeOutputSource depthOne(*root, AccessLevel::User, false, 1);
+    EXPECT_EQ(drain(depthOne), (std::vector<std::string>{"root/", "  public/", "  ping"}));
+  }
+
+  TEST_F(TreeOutputSourceTest, InaccessibleStartProducesNothing)
+  {
+    auto& admin = static_cast<Directory&>(*root->getChild(0));
+    TreeOutputSource source(admin, AccessLevel::User);
+
+    EXPECT_TRUE(drain(source).empty());
+  }
+
+}
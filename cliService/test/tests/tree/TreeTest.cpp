@@ -255,6 +255,46 @@ namespace cliService
     EXPECT_EQ(adminCmd.getAccessLevel(), AccessLevel::Admin);
   }
 
+  TEST_F(TreeTest, EffectiveAccessLevelInheritsFromAncestors)
+  {
+    auto& userDir = _root->addDynamicDirectory("user", AccessLevel::User);
+    auto& adminDir = _root->addDynamicDirectory("admin", AccessLevel::Admin);
+    auto& nestedDir = adminDir.addDynamicDirectory("nested", AccessLevel::User);
+    auto& userCmd = userDir.addDynamicCommand<TestCommand>("cmd", AccessLevel::User);
+    auto& nestedCmd = nestedDir.addDynamicCommand<TestCommand>("cmd", AccessLevel::User);
+
+    EXPECT_EQ(_root->getEffectiveAccessLevel(), AccessLevel::User);
+    EXPECT_EQ(userDir.getEffectiveAccessLevel(), AccessLevel::User);
+    EXPECT_EQ(userCmd.getEffectiveAccessLevel(), AccessLevel::User);
+    EXPECT_EQ(adminDir.getEffectiveAccessLevel(), AccessLevel::Admin);
+    EXPECT_EQ(nestedDir.getEffectiveAccessLevel(), AccessLevel::Admin);
+    EXPECT_EQ(nestedCmd.getEffectiveAccessLevel(), AccessLevel::Admin);
+
+    // Own level is unchanged
+    EXPECT_EQ(nestedCmd.getAccessLevel(), AccessLevel::User);
+  }
+
+  TEST_F(TreeTest, EffectiveAccessLevelOfStaticSubtreeAttachedLater)
+  {
+    // Build the subtree before attaching it below a restricted directory
+    Directory staticDir("static", AccessLevel::User);
+    Directory staticSubDir("sub", AccessLevel::User);
+    TestCommand staticCmd("cmd", AccessLevel::User);
+    staticDir.addStaticDirectory(staticSubDir);
+    staticSubDir.addStaticCommand(staticCmd);
+    auto& dynamicCmd = staticSubDir.addDynamicCommand<TestCommand>("dyn", AccessLevel::User);
+
+    EXPECT_EQ(staticCmd.getEffectiveAccessLevel(), AccessLevel::User);
+
+    auto& adminDir = _root->addDynamicDirectory("admin", AccessLevel::Admin);
+    adminDir.addStaticDirectory(staticDir);
+
+    EXPECT_EQ(staticDir.getEffectiveAccessLevel(), AccessLevel::Admin);
+    EXPECT_EQ(staticSubDir.getEffectiveAccessLevel(), AccessLevel::Admin);
+    EXPECT_EQ(staticCmd.getEffectiveAccessLevel(), AccessLevel::Admin);
+    EXPECT_EQ(dynamicCmd.getEffectiveAccessLevel(), AccessLevel::Admin);
+  }
+
   // Edge Cases and Error Handling
   TEST_F(TreeTest, ResolveMalformedPaths)
   {
@@ -338,6 +378,101 @@ namespace cliService
     EXPECT_EQ(nodesAtDepth[4], 1); // cmd
   }
 
+  TEST_F(TreeTest, VisitMatchesTraverse)
+  {
+    auto& dir1 = _root->addDynamicDirectory("dir1", AccessLevel::User);
+    dir1.addDynamicCommand<TestCommand>("cmd1", AccessLevel::User);
+    auto& dir2 = dir1.addDynamicDirectory("dir2", AccessLevel::Admin);
+    dir2.addDynamicCommand<TestCommand>("cmd2", AccessLevel::Admin);
+    _root->addDynamicCommand<TestCommand>("cmd3", AccessLevel::User);
+
+    std::vector<std::pair<std::string, size_t>> traversed;
+    _root->traverse([&traversed](const NodeIf& node, size_t depth) {
+      traversed.push_back({node.getName(), depth});
+    });
+
+    std::vector<std::pair<std::string, size_t>> visited;
+    bool completed = _root->visit([&visited](const NodeIf& node, size_t depth) {
+      visited.push_back({node.getName(), depth});
+    });
+
+    EXPECT_TRUE(completed);
+    EXPECT_EQ(visited, traversed);
+  }
+
+  TEST_F(TreeTest, VisitSkipChildrenPrunesSubtree)
+  {
+    auto& dir1 = _root->addDynamicDirectory("dir1", AccessLevel::User);
+    dir1.addDynamicCommand<TestCommand>("cmd1", AccessLevel::User);
+    auto& dir2 = dir1.addDynamicDirectory("dir2", AccessLevel::Admin);
+    dir2.addDynamicCommand<TestCommand>("cmd2", AccessLevel::User);
+    _root->addDynamicCommand<TestCommand>("cmd3", AccessLevel::User);
+
+    std::vector<std::string> visited;
+    _root->visit([&visited](const NodeIf& node, size_t) {
+      visited.push_back(node.getName());
+      return node.getAccessLevel() > AccessLevel::User ? TraversalAction::SkipChildren : TraversalAction::Continue;
+    });
+
+    EXPECT_EQ(visited, (std::vector<std::string>{"root", "dir1", "cmd1", "dir2", "cmd3"}));
+  }
+
+  TEST_F(TreeTest, VisitStopEndsTraversal)
+  {
+    auto& dir1 = _root->addDynamicDirectory("dir1", AccessLevel::User);
+    dir1.addDynamicCommand<TestCommand>("target", AccessLevel::User);
+    _root->addDynamicCommand<TestCommand>("after", AccessLevel::User);
+
+    std::vector<std::string> visited;
+    bool completed = _root->visit([&visited](const NodeIf& node, size_t) {
+      visited.push_back(node.getName());
+      return node.getName() == "target" ? TraversalAction::Stop : TraversalAction::Continue;
+    });
+
+    EXPECT_FALSE(completed);
+    EXPECT_EQ(visited, (std::vector<std::string>{"root", "dir1", "target"}));
+  }
+
+  TEST_F(TreeTest, VisitFrozenTreeHonorsActions)
+  {
+    auto& dir1 = _root->addDynamicDirectory("dir1", AccessLevel::Admin);
+    dir1.addDynamicCommand<TestCommand>("cmd1", AccessLevel::User);
+    auto& dir2 = _root->addDynamicDirectory("dir2", AccessLevel::User);
+    dir2.addDynamicCommand<TestCommand>("cmd2", AccessLevel::User);
+    dir2.addDynamicCommand<TestCommand>("cmd3", AccessLevel::User);
+    _root->freeze();
+
+    std::vector<std::string> visited;
+    _root->visit([&visited](const NodeIf& node, size_t) {
+      visited.push_back(node.getName());
+
+      if (node.getName() == "cmd2") { return TraversalAction::Stop; }
+      return node.getAccessLevel() > AccessLevel::User ? TraversalAction::SkipChildren : TraversalAction::Continue;
+    });
+
+    EXPECT_EQ(visited, (std::vector<std::string>{"root", "dir1", "dir2", "cmd2"}));
+  }
+
+  TEST_F(TreeTest, VisitDeepTreeWithoutRecursion)
+  {
+    constexpr size_t depth = 5000;
+    Directory* current = _root.get();
+
+    for (size_t i = 0; i < depth; ++i) {
+      current = &current->addDynamicDirectory("d", AccessLevel::User);
+    }
+
+    size_t maxDepth = 0;
+    size_t count = 0;
+    _root->visit([&](const NodeIf&, size_t d) {
+      maxDepth = std::max(maxDepth, d);
+      count++;
+    });
+
+    EXPECT_EQ(count, depth + 1);
+    EXPECT_EQ(maxDepth, depth);
+  }
+
   // Command Tests
   TEST_F(TreeTest, CommandWithDescription)
   {
@@ -0,0 +1,175 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "cliService/cli/CLIService.hpp"
+#include "cliService/tree/TreeViewCache.hpp"
+#include "mock/command/CommandMock.hpp"
+#include "mock/io/CharIOStreamMock.hpp"
+
+namespace cliService
+{
+
+  class TreeViewCacheTest : public ::testing::Test
+  {
+  protected:
+    void SetUp() override
+    {
+      // root/
+      // ├── admin/   (Admin)
+      // │   └── config
+      // ├── public/
+      // │   ├── info
+      // │   └── internal (Admin)
+      // └── ping
+      root = std::make_unique<Directory>("root", AccessLevel::User);
+      auto& adminDir = root->addDynamicDirectory("admin", AccessLevel::Admin);
+      adminDir.addDynamicCommand<CommandMock>("config", AccessLevel::User);
+      publicDir = &root->addDynamicDirectory("public", AccessLevel::User);
+      publicDir->addDynamicCommand<CommandMock>("info", AccessLevel::User, "Public info");
+      publicDir->addDynamicCommand<CommandMock>("internal", AccessLevel::Admin);
+      root->addDynamicCommand<CommandMock>("ping", AccessLevel::User);
+    }
+
+    static std::vector<std::string> names(const std::vector<const NodeIf*>& nodes)
+    {
+      std::vector<std::string> result;
+      for (const auto* node : nodes) { result.push_back(node->getName()); }
+      return result;
+    }
+
+    std::unique_ptr<Directory> root;
+    Directory* publicDir;
+  };
+
+  TEST_F(TreeViewCacheTest, VisibleChildrenPerAccessLevel)
+  {
+    auto& cache = root->getViewCache();
+
+    EXPECT_EQ(names(cache.getView(*root, AccessLevel::User).visibleChildren),
+              (std::vector<std::string>{"public", "ping"}));
+    EXPECT_EQ(names(cache.getView(*root, AccessLevel::Admin).visibleChildren),
+              (std::vector<std::string>{"admin", "public", "ping"}));
+    EXPECT_EQ(names(cache.getView(*publicDir, AccessLevel::User).visibleChildren),
+              (std::vector<std::string>{"info"}));
+  }
+
+  TEST_F(TreeViewCacheTest, CompletionIndexIsSortedAndPrefixFiltered)
+  {
+    auto& cache = root->getViewCache();
+
+    EXPECT_EQ(cache.getCompletions(*root, AccessLevel::Admin, ""),
+              (std::vector<std::string>{"admin/", "ping", "public/"}));
+    EXPECT_EQ(cache.getCompletions(*root, AccessLevel::Admin, "p"),
+              (std::vector<std::string>{"ping", "public/"}));
+    EXPECT_EQ(cache.getCompletions(*root, AccessLevel::Admin, "pu"),
+              (std::vector<std::string>{"public/"}));
+    EXPECT_TRUE(cache.getCompletions(*root, AccessLevel::User, "a").empty());
+    EXPECT_TRUE(cache.getCompletions(*root, AccessLevel::Admin, "x").empty());
+  }
+
+  TEST_F(TreeViewCacheTest, ViewsAreBuiltOnce)
+  {
+    auto& cache = root->getViewCache();
+
+    cache.getView(*root, AccessLevel::User);
+    cache.getCompletions(*root, AccessLevel::User, "p");
+    cache.getView(*root, AccessLevel::User);
+    EXPECT_EQ(cache.getBuildCount(), 1u);
+
+    cache.getView(*root, AccessLevel::Admin);
+    EXPECT_EQ(cache.getBuildCount(), 2u);
+
+    int renders = 0;
+    auto render = [&renders]() { renders++; return std::string("text"); };
+    EXPECT_EQ(cache.getListingText(*root, AccessLevel::User, "\r\n", render), "text");
+    EXPECT_EQ(cache.getListingText(*root, AccessLevel::User, "\r\n", render), "text");
+    EXPECT_EQ(renders, 1);
+
+    // Another line ending is rendered on its own
+    auto renderLf = [&renders]() { renders++; return std::string("lf"); };
+    EXPECT_EQ(cache.getListingText(*root, AccessLevel::User, "\n", renderLf), "lf");
+    EXPECT_EQ(cache.getListingText(*root, AccessLevel::User, "\r\n", renderLf), "text");
+    EXPECT_EQ(renders, 2);
+  }
+
+  TEST_F(TreeViewCacheTest, MutationInvalidatesViews)
+  {
+    auto& cache = root->getViewCache();
+    EXPECT_EQ(cache.getCompletions(*publicDir, AccessLevel::User, "").size(), 1u);
+
+    publicDir->addDynamicCommand<CommandMock>("status", AccessLevel::User);
+
+    EXPECT_EQ(cache.getCompletions(*publicDir, AccessLevel::User, ""),
+              (std::vector<std::string>{"info", "status"}));
+  }
+
+  TEST_F(TreeViewCacheTest, SessionsShareRenderedListing)
+  {
+    std::vector<User> users = {
+      {"admin", "admin123", AccessLevel::Admin},
+      {"user", "user123", AccessLevel::User}
+    };
+
+    CharIOStreamMock ioStream1;
+    CharIOStreamMock ioStream2;
+    CLIService session1(CLIServiceConfiguration{ioStream1, users, *root, 1000, 10});
+    CLIService session2(CLIServiceConfiguration{ioStream2, users, *root, 1000, 10});
+
+    session1.activate();
+    session2.activate();
+    ioStream1.queueInput("user:user123\n");
+    ioStream2.queueInput("user:user123\n");
+    session1.service();
+    session2.service();
+
+    ioStream1.clearOutput();
+    ioStream1.queueInput("?\n");
+    session1.service();
+    size_t builds = root->getViewCache().getBuildCount();
+
+    ioStream2.clearOutput();
+    ioStream2.queueInput("?\n");
+    session2.service();
+
+    EXPECT_EQ(root->getViewCache().getBuildCount(), builds);
+    EXPECT_EQ(ioStream1.getOutput(), ioStream2.getOutput());
+    EXPECT_THAT(ioStream2.getOutput(), testing::HasSubstr("public/"));
+    EXPECT_THAT(ioStream2.getOutput(), testing::Not(testing::HasSubstr("admin/")));
+
+    // A new node shows up after the cache was invalidated
+    root->addDynamicCommand<CommandMock>("status", AccessLevel::User);
+    ioStream2.clearOutput();
+    ioStream2.queueInput("?\n");
+    session2.service();
+    EXPECT_THAT(ioStream2.getOutput(), testing::HasSubstr("status"));
+  }
+
+  TEST_F(TreeViewCacheTest, SessionsKeepTheirLineEndings)
+  {
+    std::vector<User> users = {{"user", "user123", AccessLevel::User}};
+    auto lfMessages = CLIMessages::getDefaults();
+    lfMessages.setNewLine("\n");
+
+    CharIOStreamMock crlfStream;
+    CharIOStreamMock lfStream;
+    CLIService crlfSession(CLIServiceConfiguration{crlfStream, users, *root, 1000, 10});
+    CLIService lfSession(CLIServiceConfiguration{lfStream, users, *root, 1000, 10, lfMessages});
+
+    crlfSession.activate();
+    lfSession.activate();
+    crlfStream.queueInput("user:user123\n");
+    lfStream.queueInput("user:user123\n");
+    crlfSession.service();
+    lfSession.service();
+
+    crlfStream.queueInput("?\n");
+    crlfSession.service();
+
+    lfStream.clearOutput();
+    lfStream.queueInput("?\n");
+    lfSession.service();
+
+    EXPECT_THAT(lfStream.getOutput(), testing::HasSubstr("  public/\n  ping\n"));
+    EXPECT_THAT(crlfStream.getOutput(), testing::HasSubstr("  public/\r\n  ping\r\n"));
+  }
+
+}
@@ -0,0 +1,104 @@
+#include "util/AllocationCounter.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+// Every block carries its size in a header, so live bytes stay exact
+// without relying on sized delete
+namespace
+{
+  constexpr size_t HEADER_SIZE = alignof(std::max_align_t);
+
+  std::atomic<size_t> totalAllocations{0};
+  std::atomic<size_t> totalBytes{0};
+  std::atomic<size_t> liveBytes{0};
+
+  void* allocate(size_t size)
+  {
+    auto* block = static_cast<char*>(std::malloc(size + HEADER_SIZE));
+    if (!block) { return nullptr; }
+
+    *reinterpret_cast<size_t*>(block) = size;
+    totalAllocations.fetch_add(1, std::memory_order_relaxed);
+    totalBytes.fetch_add(size, std::memory_order_relaxed);
+    liveBytes.fetch_add(size, std::memory_order_relaxed);
+    return block + HEADER_SIZE;
+  }
+
+  void deallocate(void* ptr)
+  {
+    if (!ptr) { return; }
+
+    auto* block = static_cast<char*>(ptr) - HEADER_SIZE;
+    liveBytes.fetch_sub(*reinterpret_cast<size_t*>(block), std::memory_order_relaxed);
+    std::free(block);
+  }
+}
+
+void* operator new(size_t size)
+{
+  if (void* ptr = allocate(size)) { return ptr; }
+  throw std::bad_alloc();
+}
+
+
+void* operator new[](size_t size)
+{
+  return operator new(size);
+}
+
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+  return allocate(size);
+}
+
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+  return allocate(size);
+}
+
+
+void operator delete(void* ptr) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, size_t) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { deallocate(ptr); }
+
+namespace cliService
+{
+
+  AllocationCounter::AllocationCounter()
+    : _start{totalAllocations.load(), totalBytes.load()}
+  {}
+
+
+  AllocationCounter::Counts AllocationCounter::get() const
+  {
+    if (_stopped) { return _result; }
+
+    return Counts{totalAllocations.load() - _start.allocations, totalBytes.load() - _start.bytes};
+  }
+
+
+  size_t AllocationCounter::getLiveBytes()
+  {
+    return liveBytes.load();
+  }
+
+
+  AllocationCounter::Counts AllocationCounter::stop()
+  {
+    if (!_stopped)
+    {
+      _result = get();
+      _stopped = true;
+    }
+
+    return _result;
+  }
+
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <cstddef>
+
+namespace cliService
+{
+
+  // Counts heap allocations made through the global operator new while an
+  // instance is alive. Only works in executables linking AllocationCounter.cpp,
+  // which replaces the global allocation functions. Tests and benchmarks
+  // share this one replacement.
+  class AllocationCounter
+  {
+  public:
+    struct Counts
+    {
+      size_t allocations = 0;
+      size_t bytes = 0;
+    };
+
+    AllocationCounter();
+
+    // Counts since construction, the counter keeps running
+    Counts get() const;
+
+    // Counts since construction, later allocations are ignored
+    Counts stop();
+
+    // Bytes allocated and not yet freed, process wide
+    static size_t getLiveBytes();
+
+  private:
+    Counts _start;
+    Counts _result;
+    bool _stopped = false;
+  };
+
+}